@@ -0,0 +1,244 @@
+﻿#include "ApproximationFilter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace {
+
+/// Кандидат на удаление в очереди упрощения: стоимость (площадь), вершина и её версия на момент расчёта
+struct Candidate {
+    double cost;
+    int node;
+    uint32_t version;
+    bool operator>(const Candidate& other) const {
+        return cost != other.cost ? cost > other.cost : node > other.node;
+    }
+};
+
+using CandidateQueue = std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>>;
+
+}
+
+ApproximationFilter::ApproximationFilter(const Polygon& polygon, int maxVertices)
+    : polygon(polygon)
+{
+    if (polygon.vertices.size() < 3) return;
+    box = polygon.boundingBox();
+    maxVertices = std::max(4, maxVertices);
+    double extent = std::max((double)box.maxX - box.minX, (double)box.maxY - box.minY);
+    margin = 1e-9 * std::max(extent, 1.0);
+    buildOuter(maxVertices);
+    buildInner(maxVertices);
+}
+
+void ApproximationFilter::buildOuter(int maxVertices) {
+    // Выпуклая оболочка (монотонная цепочка Эндрю), против часовой стрелки, без коллинеарных точек
+    std::vector<Point> points = polygon.vertices;
+    std::sort(points.begin(), points.end());
+    std::vector<Point> hull(2 * points.size());
+    size_t k = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        while (k >= 2 && crossProduct(hull[k - 2], hull[k - 1], points[i]) <= 0) --k;
+        hull[k++] = points[i];
+    }
+    for (size_t i = points.size() - 1, lower = k + 1; i-- > 0;) {
+        while (k >= lower && crossProduct(hull[k - 2], hull[k - 1], points[i]) <= 0) --k;
+        hull[k++] = points[i];
+    }
+    hull.resize(k - 1);
+
+    int h = (int)hull.size();
+    std::vector<HullVertex> v(h);
+    std::vector<int> prev(h), next(h);
+    std::vector<uint32_t> version(h, 0);
+    std::vector<bool> alive(h, true);
+    for (int i = 0; i < h; ++i) {
+        v[i] = { hull[i].x, hull[i].y };
+        prev[i] = (i + h - 1) % h;
+        next[i] = (i + 1) % h;
+    }
+
+    // Удаление ребра a→b: прямые (prev(a), a) и (b, next(b)) продлеваются до пересечения X.
+    // Это возможно, если суммарный поворот в a и b меньше 180°; добавленная площадь — треугольник a, X, b.
+    auto intersection = [&](int a, HullVertex& x) {
+        int b = next[a];
+        const HullVertex& p = v[prev[a]];
+        const HullVertex& q = v[next[b]];
+        double d1x = v[a].x - p.x, d1y = v[a].y - p.y;
+        double d2x = q.x - v[b].x, d2y = q.y - v[b].y;
+        double denom = d1x * d2y - d1y * d2x;
+        if (denom <= 0) return false;
+        double t = ((v[b].x - v[a].x) * d2y - (v[b].y - v[a].y) * d2x) / denom;
+        x = { v[a].x + t * d1x, v[a].y + t * d1y };
+        return true;
+    };
+    auto cost = [&](int a) {
+        HullVertex x;
+        if (!intersection(a, x)) return std::numeric_limits<double>::infinity();
+        const HullVertex& b = v[next[a]];
+        return std::abs((x.x - v[a].x) * (b.y - v[a].y) - (x.y - v[a].y) * (b.x - v[a].x)) / 2;
+    };
+
+    CandidateQueue queue;
+    for (int i = 0; i < h; ++i) queue.push({ cost(i), i, 0 });
+    int count = h;
+    while (count > maxVertices && !queue.empty()) {
+        Candidate top = queue.top();
+        queue.pop();
+        if (!alive[top.node] || top.version != version[top.node]) continue;  // Устаревшая запись
+        if (top.cost == std::numeric_limits<double>::infinity()) break;     // Ни одно ребро не удаляется
+        int a = top.node;
+        int b = next[a];
+        HullVertex x;
+        intersection(a, x);
+        v[a] = x;  // Вершина a переезжает в точку пересечения, вершина b удаляется
+        alive[b] = false;
+        next[a] = next[b];
+        prev[next[b]] = a;
+        --count;
+        // Изменились только рёбра, начинающиеся в prev(a) и в a
+        for (int node : { prev[a], a }) {
+            queue.push({ cost(node), node, ++version[node] });
+        }
+    }
+
+    int start = 0;
+    while (!alive[start]) ++start;
+    int node = start;
+    do {
+        outer.push_back(v[node]);
+        node = next[node];
+    } while (node != start);
+}
+
+void ApproximationFilter::buildInner(int maxVertices) {
+    const std::vector<Point>& v = polygon.vertices;
+    int n = (int)v.size();
+    std::vector<int> prev(n), next(n);
+    std::vector<uint32_t> version(n, 0);
+    std::vector<bool> alive(n, true);
+    for (int i = 0; i < n; ++i) {
+        prev[i] = (i + n - 1) % n;
+        next[i] = (i + 1) % n;
+    }
+
+    // Сетка вершин для проверки «нет вершин в треугольнике уха» без перебора всех вершин
+    int cells = std::max(1, (int)std::ceil(std::sqrt((double)n)));
+    double cellWidth = std::max(((double)box.maxX - box.minX) / cells, 1e-9);
+    double cellHeight = std::max(((double)box.maxY - box.minY) / cells, 1e-9);
+    auto column = [&](double x) { return std::min(std::max((int)std::floor((x - box.minX) / cellWidth), 0), cells - 1); };
+    auto row = [&](double y) { return std::min(std::max((int)std::floor((y - box.minY) / cellHeight), 0), cells - 1); };
+    std::vector<std::vector<int>> grid((size_t)cells * cells);
+    for (int i = 0; i < n; ++i) grid[(size_t)row(v[i].y) * cells + column(v[i].x)].push_back(i);
+
+    // Ухо: выпуклая вершина, в треугольнике (prev, i, next) которой (включая границу) нет других вершин
+    auto isEar = [&](int i) {
+        const Point& a = v[prev[i]];
+        const Point& b = v[i];
+        const Point& c = v[next[i]];
+        if (crossProduct(a, b, c) <= 0) return false;
+        BoundingBox tri = BoundingBox::fromSegment(a, b);
+        tri.expand(c);
+        for (int r = row(tri.minY); r <= row(tri.maxY); ++r) {
+            for (int col = column(tri.minX); col <= column(tri.maxX); ++col) {
+                for (int j : grid[(size_t)r * cells + col]) {
+                    if (!alive[j] || j == i || j == prev[i] || j == next[i] || !tri.contains(v[j])) continue;
+                    if (crossProduct(a, b, v[j]) >= 0 && crossProduct(b, c, v[j]) >= 0 && crossProduct(c, a, v[j]) >= 0) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    };
+    auto cost = [&](int i) {
+        if (!isEar(i)) return std::numeric_limits<double>::infinity();
+        return crossProduct(v[prev[i]], v[i], v[next[i]]) / 2;
+    };
+
+    CandidateQueue queue;
+    for (int i = 0; i < n; ++i) queue.push({ cost(i), i, 0 });
+    int count = n;
+    while (count > maxVertices && count > 3 && !queue.empty()) {
+        Candidate top = queue.top();
+        queue.pop();
+        if (!alive[top.node] || top.version != version[top.node]) continue;
+        if (top.cost == std::numeric_limits<double>::infinity()) {
+            // Вершина могла стать ухом после удаления вершины из её треугольника (не соседней) —
+            // пересчитываем все; если ушей так и не нашлось, упрощение закончено
+            bool found = false;
+            for (int j = 0; j < n; ++j) {
+                if (!alive[j]) continue;
+                double c = cost(j);
+                found = found || c != std::numeric_limits<double>::infinity();
+                queue.push({ c, j, ++version[j] });
+            }
+            if (!found) break;
+            continue;
+        }
+        int i = top.node;
+        alive[i] = false;  // Отсекаем ухо: соседи соединяются диагональю внутри многоугольника
+        next[prev[i]] = next[i];
+        prev[next[i]] = prev[i];
+        --count;
+        for (int node : { prev[i], next[i] }) {
+            queue.push({ cost(node), node, ++version[node] });
+        }
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (alive[i]) inner.push_back(v[i]);
+    }
+}
+
+bool ApproximationFilter::outsideOuter(const Point& p) const {
+    size_t h = outer.size();
+    for (size_t i = 0; i < h; ++i) {
+        const HullVertex& a = outer[i];
+        const HullVertex& b = outer[(i + 1) % h];
+        double cross = (b.x - a.x) * ((double)p.y - a.y) - (b.y - a.y) * ((double)p.x - a.x);
+        // Справа от ребра выпуклого многоугольника против часовой стрелки — снаружи
+        if (cross < -margin * std::hypot(b.x - a.x, b.y - a.y)) return true;
+    }
+    return false;
+}
+
+bool ApproximationFilter::insideInner(const Point& p) const {
+    size_t n = inner.size();
+    bool inside = false;
+    for (size_t i = 0; i < n; ++i) {
+        const Point& a = inner[i];
+        const Point& b = inner[(i + 1) % n];
+        if (pointOnSegment(a, p, b)) return true;
+        if ((a.y > p.y) != (b.y > p.y)) {
+            double cross = crossProduct(a, b, p);
+            if ((b.y > a.y) ? cross > 0 : cross < 0) inside = !inside;
+        }
+    }
+    return inside;
+}
+
+FilterResult ApproximationFilter::classify(const Point& p) const {
+    if (outer.empty()) return FilterResult::uncertain;
+    if (!box.contains(p) || outsideOuter(p)) return FilterResult::outside;
+    if (insideInner(p)) return FilterResult::inside;
+    return FilterResult::uncertain;
+}
+
+bool ApproximationFilter::contains(const Point& p) const {
+    switch (classify(p)) {
+    case FilterResult::inside: return true;
+    case FilterResult::outside: return false;
+    default: return polygon.contains(p);  // Полоса между приближениями — полная проверка
+    }
+}
+
+std::vector<Point> ApproximationFilter::outerHull() const {
+    std::vector<Point> points;
+    for (const HullVertex& vertex : outer) points.push_back(Point((float)vertex.x, (float)vertex.y));
+    return points;
+}
@@ -0,0 +1,71 @@
+﻿#pragma once
+
+#include "Geometry.h"
+#include "Point.h"
+#include "Polygon.h"
+#include <vector>
+
+/// Результат быстрой проверки фильтром
+enum class FilterResult {
+    outside,   // Точка заведомо вне многоугольника
+    inside,    // Точка заведомо принадлежит многоугольнику
+    uncertain  // Точка в полосе между приближениями — нужна полная проверка
+};
+
+/// \brief Двухступенчатый фильтр: внешнее и внутреннее упрощённые приближения многоугольника.
+///
+/// Внешнее приближение — выпуклая оболочка вершин, упрощённая по Висвалингаму с сохранением
+/// охвата: вместо удаления вершины убирается ребро, а соседние рёбра продлеваются до пересечения,
+/// каждый раз выбирается ребро с наименьшей добавленной площадью. Внутреннее приближение получается
+/// отсечением «ушей» (выпуклая вершина, в треугольнике которой нет других вершин) — тоже начиная с
+/// наименьшего по площади, поэтому оно всегда лежит внутри многоугольника. Точки вне прямоугольника
+/// или внешнего приближения и точки внутри внутреннего отвечаются по нескольким десяткам рёбер;
+/// только точки в полосе между ними проверяются Polygon::contains.
+/// После построения объект неизменяем, поэтому запросы можно выполнять из нескольких потоков.
+class ApproximationFilter {
+public:
+    /// Пустой фильтр (все точки — uncertain)
+    ApproximationFilter() = default;
+
+    /// \brief Строит приближения для валидного многоугольника (вершины против часовой стрелки).
+    /// \param polygon     Многоугольник (копируется для полных проверок).
+    /// \param maxVertices Наибольшее число вершин каждого приближения (не меньше 4).
+    explicit ApproximationFilter(const Polygon& polygon, int maxVertices = 32);
+
+    /// \brief Быстрая проверка по прямоугольнику и приближениям.
+    FilterResult classify(const Point& p) const;
+
+    /// \brief Полная проверка: classify, а для uncertain — Polygon::contains.
+    bool contains(const Point& p) const;
+
+    /// Вершины внешнего приближения (против часовой стрелки)
+    std::vector<Point> outerHull() const;
+
+    /// Вершины внутреннего приближения (подмножество вершин многоугольника, в исходном порядке)
+    const std::vector<Point>& innerPolygon() const { return inner; }
+
+private:
+    /// Вершина внешнего приближения в double (точки пересечения продлённых рёбер)
+    struct HullVertex {
+        double x;
+        double y;
+    };
+
+    Polygon polygon;                // Многоугольник для полных проверок
+    BoundingBox box;                // Ограничивающий прямоугольник
+    std::vector<HullVertex> outer;  // Внешнее выпуклое приближение
+    std::vector<Point> inner;       // Внутреннее приближение
+    double margin = 0.0;            // Допуск внешней проверки на погрешность точек пересечения
+
+    /// Построение внешнего приближения
+    void buildOuter(int maxVertices);
+
+    /// Построение внутреннего приближения
+    void buildInner(int maxVertices);
+
+    /// Точка строго вне внешнего приближения (с допуском margin)
+    bool outsideOuter(const Point& p) const;
+
+    /// Точка внутри или на границе внутреннего приближения
+    bool insideInner(const Point& p) const;
+};
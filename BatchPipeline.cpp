@@ -0,0 +1,213 @@
+﻿#include "BatchPipeline.h"
+#include "BoundedQueue.h"
+#include "FileParser.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Блок конвейера: проходит все стадии и возвращается в пул после записи
+struct PipelineBlock {
+    size_t sequence = 0;           // Порядковый номер блока в файле
+    int firstLine = 0;             // Номер первой строки блока в файле
+    std::string text;              // Целые строки файла
+    std::vector<Point> points;     // Разобранные точки
+    std::vector<uint8_t> results;  // Результаты contains
+    bool failed = false;           // Ошибка разбора в блоке
+    Error err;                     // Сведения об ошибке
+};
+
+}
+
+BatchPipeline::BatchPipeline(const Polygon& polygon, const PipelineOptions& options)
+    : polygon(polygon), options(options)
+{
+    if (options.approximationFilter) {
+        filter = ApproximationFilter(polygon);
+    }
+}
+
+bool BatchPipeline::run(const std::string& inputPath, long long bodyOffset, int firstLine,
+    const std::string& outputPath, Error& err, PipelineStats* stats) const {
+    auto started = std::chrono::steady_clock::now();
+    err.errorInputFileWay = inputPath;
+
+    std::ifstream fin(inputPath, std::ios::binary);
+    if (!fin.is_open()) {
+        err.type = ErrorType::inputFileNotExist;
+        err.errorMessage = "Неверно указан файл с входными данными. Возможно, файл не существует или нет прав на чтение.";
+        return false;
+    }
+    fin.seekg(bodyOffset);
+
+    ResultWriter writer(options.output);
+    if (!writer.open(outputPath, err)) {
+        return false;
+    }
+
+    // Число потоков по стадиям: поток чтения и поток записи (вызывающий) плюс разбор и классификация
+    int cores = std::max(2, (int)std::thread::hardware_concurrency());
+    int parsers = options.parserThreads > 0 ? options.parserThreads : std::max(1, (cores - 1) / 2);
+    int classifiers = options.classifierThreads > 0 ? options.classifierThreads : std::max(1, cores - 1 - parsers);
+    size_t poolSize = options.blocksInFlight > 0 ? (size_t)options.blocksInFlight : (size_t)(2 * (parsers + classifiers) + 2);
+    size_t chunkBytes = std::max<size_t>(options.chunkBytes, 64);
+
+    // Пул блоков и очереди между стадиями; место хватает на все блоки и маркеры завершения (nullptr)
+    std::vector<std::unique_ptr<PipelineBlock>> storage;
+    size_t queueCapacity = poolSize + parsers + classifiers + 1;
+    BoundedQueue<PipelineBlock*> freeBlocks(queueCapacity);
+    BoundedQueue<PipelineBlock*> rawBlocks(queueCapacity);
+    BoundedQueue<PipelineBlock*> parsedBlocks(queueCapacity);
+    BoundedQueue<PipelineBlock*> doneBlocks(queueCapacity);
+    for (size_t i = 0; i < poolSize; ++i) {
+        storage.emplace_back(new PipelineBlock());
+        freeBlocks.push(storage.back().get());
+    }
+
+    std::atomic<bool> cancelled(false);  // Выставляется записью при первой ошибке
+    std::atomic<int> parsersLeft(parsers);
+    std::atomic<int> classifiersLeft(classifiers);
+
+    // Стадия 1: чтение порций файла, обрезанных по последнему переводу строки
+    std::thread reader([&]() {
+        std::vector<char> buffer(chunkBytes);
+        std::string carry;  // Незавершённая строка из предыдущей порции
+        size_t sequence = 0;
+        int line = firstLine;
+        while (!cancelled.load(std::memory_order_relaxed)) {
+            fin.read(buffer.data(), (std::streamsize)buffer.size());
+            size_t got = (size_t)fin.gcount();
+            bool eof = got < buffer.size();
+            if (got == 0 && carry.empty()) break;
+
+            PipelineBlock* block = freeBlocks.pop();  // Ждёт, если все блоки в работе
+            block->text.swap(carry);
+            block->text.append(buffer.data(), got);
+            carry.clear();
+            if (!eof) {
+                size_t cut = block->text.rfind('\n');
+                if (cut == std::string::npos) {  // Строка длиннее порции — читаем дальше
+                    carry.swap(block->text);
+                    freeBlocks.push(block);
+                    continue;
+                }
+                carry.assign(block->text, cut + 1, std::string::npos);
+                block->text.resize(cut + 1);
+            }
+            if (!block->text.empty()) {
+                block->sequence = sequence++;
+                block->firstLine = line;
+                line += (int)std::count(block->text.begin(), block->text.end(), '\n');
+                if (block->text.back() != '\n') ++line;
+                rawBlocks.push(block);
+            }
+            else {
+                freeBlocks.push(block);
+            }
+            if (eof) break;
+        }
+        for (int i = 0; i < parsers; ++i) rawBlocks.push(nullptr);
+    });
+
+    // Стадия 2: разбор строк блока в точки
+    std::vector<std::thread> workers;
+    for (int t = 0; t < parsers; ++t) {
+        workers.emplace_back([&]() {
+            for (PipelineBlock* block = rawBlocks.pop(); block != nullptr; block = rawBlocks.pop()) {
+                block->points.clear();
+                block->failed = false;
+                const char* p = block->text.data();
+                const char* end = p + block->text.size();
+                int line = block->firstLine;
+                while (p < end && !cancelled.load(std::memory_order_relaxed)) {
+                    const char* newline = static_cast<const char*>(std::memchr(p, '\n', (size_t)(end - p)));
+                    const char* lineEnd = newline != nullptr ? newline : end;
+                    Point point;
+                    if (!FileParser::parseQueryLine(p, lineEnd, point, block->err, line)) {
+                        block->failed = true;
+                        break;
+                    }
+                    block->points.push_back(point);
+                    ++line;
+                    p = newline != nullptr ? newline + 1 : end;
+                }
+                parsedBlocks.push(block);
+            }
+            if (--parsersLeft == 0) {
+                for (int i = 0; i < classifiers; ++i) parsedBlocks.push(nullptr);
+            }
+        });
+    }
+
+    // Стадия 3: классификация точек блока
+    for (int t = 0; t < classifiers; ++t) {
+        workers.emplace_back([&]() {
+            for (PipelineBlock* block = parsedBlocks.pop(); block != nullptr; block = parsedBlocks.pop()) {
+                block->results.resize(block->points.size());
+                if (!block->failed && !cancelled.load(std::memory_order_relaxed)) {
+                    for (size_t i = 0; i < block->points.size(); ++i) {
+                        const Point& p = block->points[i];
+                        block->results[i] = (options.approximationFilter ? filter.contains(p) : polygon.contains(p)) ? 1 : 0;
+                    }
+                }
+                doneBlocks.push(block);
+            }
+            if (--classifiersLeft == 0) doneBlocks.push(nullptr);
+        });
+    }
+
+    // Запись в вызывающем потоке: блоки восстанавливаются в исходном порядке
+    std::map<size_t, PipelineBlock*> pending;
+    size_t nextSequence = 0;
+    size_t totalPoints = 0;
+    size_t totalBlocks = 0;
+    bool failed = false;
+    for (PipelineBlock* block = doneBlocks.pop(); block != nullptr; block = doneBlocks.pop()) {
+        pending[block->sequence] = block;
+        while (!pending.empty() && pending.begin()->first == nextSequence) {
+            PipelineBlock* ready = pending.begin()->second;
+            pending.erase(pending.begin());
+            ++nextSequence;
+            if (!failed) {
+                if (ready->failed) {
+                    failed = true;
+                    err = ready->err;
+                    err.errorInputFileWay = inputPath;
+                    cancelled.store(true);
+                }
+                else {
+                    writer.write(ready->results.data(), ready->results.size());
+                    totalPoints += ready->points.size();
+                    ++totalBlocks;
+                }
+            }
+            freeBlocks.push(ready);
+        }
+    }
+    reader.join();
+    for (std::thread& worker : workers) worker.join();
+
+    if (stats != nullptr) {
+        stats->points = totalPoints;
+        stats->blocks = totalBlocks;
+        stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    }
+    if (failed) return false;
+
+    // Должна быть хотя бы одна проверяемая точка
+    if (totalPoints == 0) {
+        err.type = ErrorType::verticesMismatch;
+        err.errorLineNumber = firstLine;
+        err.errorMessage = "Не хватает данных для тестовой точки.";
+        return false;
+    }
+    return writer.close(err);
+}
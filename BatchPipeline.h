@@ -0,0 +1,57 @@
+﻿#pragma once
+
+#include "ApproximationFilter.h"
+#include "Error.h"
+#include "Polygon.h"
+#include "ResultWriter.h"
+#include <cstddef>
+#include <string>
+
+/// \brief Настройки конвейера пакетной обработки.
+struct PipelineOptions {
+    size_t chunkBytes = 1 << 20;  // Размер порции чтения файла, байт
+    int parserThreads = 0;        // Потоки разбора; 0 — по числу ядер
+    int classifierThreads = 0;    // Потоки проверки contains; 0 — по числу ядер
+    int blocksInFlight = 0;       // Блоков одновременно в работе (ограничивает память); 0 — автоматически
+    ResultWriterOptions output;   // Формат и буферизация записи результатов
+    bool approximationFilter = false;  // Отсекать точки приближениями (ApproximationFilter) до полной проверки
+};
+
+/// \brief Статистика выполнения конвейера.
+struct PipelineStats {
+    size_t points = 0;     // Обработано точек
+    size_t blocks = 0;     // Обработано блоков
+    double seconds = 0.0;  // Время выполнения run()
+};
+
+/// \brief Трёхстадийный конвейер пакетной проверки точек: чтение → разбор → классификация.
+///
+/// Поток чтения заполняет буферы порциями файла, обрезанными по границе строки; потоки разбора
+/// превращают их в блоки точек (FileParser::parseQueryLine); потоки классификации выполняют
+/// Polygon::contains. Стадии связаны ограниченными очередями без блокировок (BoundedQueue),
+/// блоки берутся из фиксированного пула и возвращаются в него после записи, поэтому чтение
+/// с диска и вычисления перекрываются, а потребление памяти не зависит от размера файла.
+/// Результаты записываются в исходном порядке; при ошибке разбора сообщается первая по порядку
+/// строка с ошибкой (с глобальным номером строки), как при последовательном чтении.
+class BatchPipeline {
+public:
+    /// \brief Создаёт конвейер для валидного многоугольника.
+    BatchPipeline(const Polygon& polygon, const PipelineOptions& options = PipelineOptions());
+
+    /// \brief Обрабатывает строки точек входного файла и записывает результаты в формате options.output.
+    /// \param[in]  inputPath  Входной файл.
+    /// \param[in]  bodyOffset Смещение первой строки точек (см. FileParser::readPolygonHeader).
+    /// \param[in]  firstLine  Номер первой строки точек в файле (для сообщений об ошибках).
+    /// \param[in]  outputPath Выходной файл.
+    /// \param[out] err        Ошибка разбора (как у FileParser) или outputFileCreateFail.
+    /// \param[out] stats      Статистика (может быть nullptr).
+    /// \return true, если все строки разобраны и результаты записаны. При ошибке разбора выходной
+    ///         файл содержит результаты только для строк до ошибочного блока.
+    bool run(const std::string& inputPath, long long bodyOffset, int firstLine,
+        const std::string& outputPath, Error& err, PipelineStats* stats = nullptr) const;
+
+private:
+    Polygon polygon;          // Проверяемый многоугольник
+    PipelineOptions options;  // Настройки
+    ApproximationFilter filter;  // Приближения многоугольника (если включены в options)
+};
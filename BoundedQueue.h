@@ -0,0 +1,107 @@
+﻿#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/// \brief Ограниченная очередь без блокировок для нескольких производителей и потребителей.
+///
+/// Кольцевой буфер с порядковым номером в каждой ячейке (схема Д. Вьюкова): tryPush/tryPop
+/// не берут мьютексов и не выделяют память. push/pop ждут, пока появится место или элемент, —
+/// так заполненная очередь притормаживает производителя (back-pressure), и память не растёт.
+template <class T>
+class BoundedQueue {
+public:
+    /// \brief Создаёт очередь; ёмкость округляется вверх до степени двойки.
+    explicit BoundedQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        cells = std::vector<Cell>(size);
+        mask = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /// \brief Пытается добавить элемент; при заполненной очереди возвращает false, value не изменяется.
+    bool tryPush(T& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)position;
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false;  // Очередь заполнена
+            }
+            else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// \brief Пытается извлечь элемент; при пустой очереди возвращает false.
+    bool tryPop(T& value) {
+        size_t position = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)(position + 1);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.sequence.store(position + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false;  // Очередь пуста
+            }
+            else {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Добавляет элемент, ожидая свободного места
+    void push(T value) {
+        for (int attempt = 0; !tryPush(value); ++attempt) backoff(attempt);
+    }
+
+    /// Извлекает элемент, ожидая его появления
+    T pop() {
+        T value;
+        for (int attempt = 0; !tryPop(value); ++attempt) backoff(attempt);
+        return value;
+    }
+
+private:
+    /// Ячейка кольцевого буфера
+    struct Cell {
+        std::atomic<size_t> sequence{ 0 };
+        T value{};
+    };
+
+    std::vector<Cell> cells;         // Кольцевой буфер
+    size_t mask = 0;                 // Ёмкость - 1
+    alignas(64) std::atomic<size_t> head{ 0 };  // Позиция чтения
+    alignas(64) std::atomic<size_t> tail{ 0 };  // Позиция записи
+
+    /// Ожидание: сначала уступаем процессор, при долгом простое — короткий сон
+    static void backoff(int attempt) {
+        if (attempt < 64) std::this_thread::yield();
+        else std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+};
@@ -0,0 +1,138 @@
+﻿#include "CrossingQuery.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+CrossingQuery::CrossingQuery(const Polygon& polygon)
+    : index(polygon)
+{
+    if (polygon.signedArea() < 0) side = -1.0;
+}
+
+void CrossingQuery::append(const Point& a, const Point& b, std::vector<int>& candidates, std::vector<Crossing>& out) const {
+    size_t first = out.size();
+    index.segmentCandidates(a, b, candidates);
+
+    double dx = (double)b.x - a.x;
+    double dy = (double)b.y - a.y;
+    double length = dx * dx + dy * dy;
+    for (int e : candidates) {
+        const Point& p = index.edgeStart(e);
+        const Point& q = index.edgeEnd(e);
+        int s1 = crossSign(a, b, p);
+        int s2 = crossSign(a, b, q);
+        int s3 = crossSign(p, q, a);
+        int s4 = crossSign(p, q, b);
+        if (s1 * s2 > 0 || s3 * s4 > 0) continue;  // Ребро целиком по одну сторону отрезка или наоборот
+
+        double ex = (double)q.x - p.x;
+        double ey = (double)q.y - p.y;
+        double edgeLength = ex * ex + ey * ey;
+        if (s1 == 0 && s2 == 0) {
+            // Коллинеарны: общая часть — пересечение проекций ребра на отрезок
+            if (length == 0) {  // Отрезок-точка
+                if (pointOnSegment(p, a, q)) {
+                    out.push_back({ e, 0.0, (((double)a.x - p.x) * ex + ((double)a.y - p.y) * ey) / edgeLength, CrossingKind::touching });
+                }
+                continue;
+            }
+            double tp = (((double)p.x - a.x) * dx + ((double)p.y - a.y) * dy) / length;
+            double tq = (((double)q.x - a.x) * dx + ((double)q.y - a.y) * dy) / length;
+            double from = std::max(0.0, std::min(tp, tq));
+            double to = std::min(1.0, std::max(tp, tq));
+            if (from > to) continue;
+            double edgeT = (from - tp) / (tq - tp);
+            out.push_back({ e, from, std::min(std::max(edgeT, 0.0), 1.0), CrossingKind::touching });
+            continue;
+        }
+
+        // Прямые пересекаются в одной точке, и она лежит на обоих отрезках
+        double cA = crossProduct(p, q, a);
+        double cB = crossProduct(p, q, b);
+        double t = cA / (cA - cB);
+        double cP = crossProduct(a, b, p);
+        double cQ = crossProduct(a, b, q);
+        double edgeT = cP / (cP - cQ);
+        if (s3 == 0) t = 0.0;  // Точные значения для концов — без погрешности деления
+        if (s4 == 0) t = 1.0;
+        if (s1 == 0) edgeT = 0.0;
+        if (s2 == 0) edgeT = 1.0;
+
+        CrossingKind kind = CrossingKind::touching;
+        if (s1 * s2 < 0 && s3 * s4 < 0) {
+            // Конец b по ту же сторону ребра, что и внутренность, — отрезок входит
+            kind = side * s4 > 0 ? CrossingKind::entering : CrossingKind::leaving;
+        }
+        out.push_back({ e, t, edgeT, kind });
+    }
+    std::sort(out.begin() + first, out.end(), [](const Crossing& l, const Crossing& r) {
+        return l.t != r.t ? l.t < r.t : l.edge < r.edge;
+    });
+}
+
+void CrossingQuery::crossings(const Point& a, const Point& b, std::vector<Crossing>& out) const {
+    out.clear();
+    std::vector<int> candidates;
+    append(a, b, candidates, out);
+}
+
+void CrossingQuery::polyline(const std::vector<Point>& points, CrossingResult& result) const {
+    result.offsets.assign(1, 0);
+    result.crossings.clear();
+    std::vector<int> candidates;
+    for (size_t k = 1; k < points.size(); ++k) {
+        append(points[k - 1], points[k], candidates, result.crossings);
+        result.offsets.push_back(result.crossings.size());
+    }
+}
+
+void CrossingQuery::batch(const std::vector<QuerySegment>& segments, CrossingResult& result, int threads) const {
+    size_t count = segments.size();
+    const size_t chunkSize = 1024;
+    size_t chunks = (count + chunkSize - 1) / chunkSize;
+    if (threads <= 0) {
+        threads = count >= 4096 ? std::max(1, (int)std::thread::hardware_concurrency()) : 1;
+    }
+    threads = (int)std::max<size_t>(1, std::min<size_t>(threads, chunks));
+
+    // Каждая порция отрезков пишет в свой вектор; затем порции склеиваются по порядку
+    result.offsets.assign(count + 1, 0);
+    std::vector<std::vector<Crossing>> found(chunks);
+    auto processChunk = [&](size_t chunk, std::vector<int>& candidates) {
+        size_t from = chunk * chunkSize;
+        size_t to = std::min(count, from + chunkSize);
+        for (size_t i = from; i < to; ++i) {
+            size_t before = found[chunk].size();
+            append(segments[i].a, segments[i].b, candidates, found[chunk]);
+            result.offsets[i + 1] = found[chunk].size() - before;
+        }
+    };
+    if (threads == 1) {
+        std::vector<int> candidates;
+        for (size_t chunk = 0; chunk < chunks; ++chunk) processChunk(chunk, candidates);
+    }
+    else {
+        std::atomic<size_t> nextChunk(0);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&]() {
+                std::vector<int> candidates;
+                for (size_t chunk = nextChunk++; chunk < chunks; chunk = nextChunk++) processChunk(chunk, candidates);
+            });
+        }
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    for (size_t i = 0; i < count; ++i) result.offsets[i + 1] += result.offsets[i];
+    result.crossings.clear();
+    result.crossings.reserve(result.offsets.back());
+    for (const std::vector<Crossing>& part : found) {
+        result.crossings.insert(result.crossings.end(), part.begin(), part.end());
+    }
+}
+
+bool CrossingQuery::crossesBoundary(const Point& a, const Point& b) const {
+    std::vector<Crossing> found;
+    crossings(a, b, found);
+    return std::any_of(found.begin(), found.end(), [](const Crossing& c) { return c.kind != CrossingKind::touching; });
+}
@@ -0,0 +1,73 @@
+﻿#pragma once
+
+#include "EdgeIndex.h"
+#include "Point.h"
+#include "Polygon.h"
+#include <cstddef>
+#include <vector>
+
+/// \brief Вид общей точки отрезка запроса и ребра многоугольника.
+enum class CrossingKind {
+    entering,  // Собственное пересечение, отрезок входит в многоугольник
+    leaving,   // Собственное пересечение, отрезок выходит из многоугольника
+    touching   // Касание: конец отрезка на ребре, проход через вершину или наложение на ребро
+};
+
+/// \brief Общая точка отрезка запроса [a,b] и ребра многоугольника.
+struct Crossing {
+    int edge;           // Индекс ребра (ребро i: вершины i и (i + 1) % n)
+    double t;           // Положение на отрезке запроса: a + t (b - a), t ∈ [0,1]; для наложения — начало общей части
+    double edgeT;       // Положение той же точки на ребре, ∈ [0,1]
+    CrossingKind kind;  // Вид пересечения
+};
+
+/// \brief Отрезок запроса.
+struct QuerySegment {
+    Point a;  // Начало
+    Point b;  // Конец
+};
+
+/// \brief Пересечения для набора отрезков (формат CSR).
+///
+/// Пересечения отрезка i лежат в crossings[offsets[i] .. offsets[i + 1]) по возрастанию t.
+struct CrossingResult {
+    std::vector<size_t> offsets;      // Размер: число отрезков + 1
+    std::vector<Crossing> crossings;  // Пересечения всех отрезков подряд
+};
+
+/// \brief Поиск пересечений отрезков и ломаных (например, участков дорог) с границей многоугольника.
+///
+/// Рёбра-кандидаты берутся из EdgeIndex по ячейкам, через которые проходит отрезок, и только они
+/// проверяются точными предикатами из Geometry.h — без перебора всех рёбер, как при валидации.
+/// После построения объект неизменяем, запросы можно выполнять из нескольких потоков.
+class CrossingQuery {
+public:
+    /// \brief Строит индекс рёбер многоугольника.
+    /// \param polygon Простой многоугольник (вершины копируются); порядок обхода любой.
+    explicit CrossingQuery(const Polygon& polygon);
+
+    /// \brief Пересечения отрезка [a,b] с границей.
+    /// \param[out] out Пересечения по возрастанию t (при равных t — по номеру ребра); очищается перед заполнением.
+    void crossings(const Point& a, const Point& b, std::vector<Crossing>& out) const;
+
+    /// \brief Пересечения ломаной points[0], points[1], ... с границей.
+    /// \param[out] result Пересечения звена k (от points[k] к points[k + 1]) — в CSR-строке k;
+    ///                    строк points.size() - 1 (для ломаной из одной точки и пустой — ни одной).
+    void polyline(const std::vector<Point>& points, CrossingResult& result) const;
+
+    /// \brief Пересечения набора независимых отрезков.
+    /// \param[out] result  Пересечения отрезка i — в CSR-строке i.
+    /// \param      threads Число потоков; 0 — по числу ядер для больших наборов (от 4096 отрезков), иначе один.
+    void batch(const std::vector<QuerySegment>& segments, CrossingResult& result, int threads = 0) const;
+
+    /// \brief Входит ли отрезок в многоугольник или выходит из него (есть собственное пересечение).
+    bool crossesBoundary(const Point& a, const Point& b) const;
+
+private:
+    EdgeIndex index;    // Индекс рёбер для отбора кандидатов
+    double side = 1.0;  // 1 — обход против часовой стрелки (внутренность слева от рёбер), -1 — по часовой
+
+    /// \brief Дописывает в out пересечения отрезка [a,b] в порядке возрастания t.
+    /// \param candidates Рабочий вектор для кандидатов из индекса.
+    void append(const Point& a, const Point& b, std::vector<int>& candidates, std::vector<Crossing>& out) const;
+};
@@ -0,0 +1,119 @@
+﻿#include "EdgeIndex.h"
+#include <algorithm>
+#include <cmath>
+
+EdgeIndex::EdgeIndex(const Polygon& polygon, int cellsPerAxis)
+    : vertices(polygon.vertices)
+{
+    int n = (int)vertices.size();
+    if (n == 0) return;
+
+    box = polygon.boundingBox();
+
+    // Около одного ребра на ячейку: sqrt(n) x sqrt(n)
+    if (cellsPerAxis <= 0) {
+        cellsPerAxis = (int)std::ceil(std::sqrt((double)n));
+    }
+    cols = rowCount = std::max(1, cellsPerAxis);
+
+    // Вырожденная по одной из осей сетка (например, все точки на прямой) — ячейка единичного размера
+    float width = box.maxX - box.minX;
+    float height = box.maxY - box.minY;
+    cellWidth = width > 0 ? width / cols : 1.0f;
+    cellHeight = height > 0 ? height / rowCount : 1.0f;
+
+    // Два прохода: подсчёт числа рёбер в ячейках, затем раскладка (CSR)
+    std::vector<uint32_t> counts((size_t)cols * rowCount + 1, 0);
+    for (int i = 0; i < n; ++i) {
+        forEachCellOnSegment(edgeStart(i), edgeEnd(i), [&](int cell) { ++counts[cell + 1]; });
+    }
+    for (size_t c = 1; c < counts.size(); ++c) {
+        counts[c] += counts[c - 1];
+    }
+    cellStart = counts;
+    cellEdges.resize(cellStart.back());
+    for (int i = 0; i < n; ++i) {
+        forEachCellOnSegment(edgeStart(i), edgeEnd(i), [&](int cell) { cellEdges[counts[cell]++] = (uint32_t)i; });
+    }
+}
+
+int EdgeIndex::columnOf(double x) const {
+    int c = (int)std::floor((x - box.minX) / cellWidth);
+    return std::min(std::max(c, 0), cols - 1);
+}
+
+int EdgeIndex::rowOf(double y) const {
+    int r = (int)std::floor((y - box.minY) / cellHeight);
+    return std::min(std::max(r, 0), rowCount - 1);
+}
+
+template <class Visitor>
+void EdgeIndex::forEachCellOnSegment(const Point& a, const Point& b, Visitor visit) const {
+    // Отрезок целиком вне сетки — ячеек нет
+    if (!box.intersects(BoundingBox::fromSegment(a, b))) return;
+
+    double ax = a.x, ay = a.y, bx = b.x, by = b.y;
+    if (ay > by) {  // Идём снизу вверх
+        std::swap(ax, bx);
+        std::swap(ay, by);
+    }
+    // Строки берутся с запасом в одну: конец отрезка ровно на границе строк попадает в обе
+    int rowFrom = std::max(rowOf(ay) - 1, 0);
+    int rowTo = std::min(rowOf(by) + 1, rowCount - 1);
+    for (int r = rowFrom; r <= rowTo; ++r) {
+        // Часть отрезка, попадающая в полосу строки r (для соседних строк — ближайший конец)
+        double y0 = std::max(ay, (double)box.minY + (double)r * cellHeight);
+        double y1 = std::min(by, (double)box.minY + (double)(r + 1) * cellHeight);
+        if (y0 > y1) {
+            y0 = y1 = (y0 > by) ? by : ay;
+        }
+        double x0, x1;
+        if (by == ay) {  // Горизонтальный отрезок
+            x0 = ax;
+            x1 = bx;
+        }
+        else {
+            x0 = ax + (bx - ax) * (y0 - ay) / (by - ay);
+            x1 = ax + (bx - ax) * (y1 - ay) / (by - ay);
+        }
+        if (x0 > x1) std::swap(x0, x1);
+        // Запас в одну ячейку с каждой стороны покрывает ошибки округления на границах ячеек
+        int colFrom = std::max(columnOf(x0) - 1, 0);
+        int colTo = std::min(columnOf(x1) + 1, cols - 1);
+        for (int c = colFrom; c <= colTo; ++c) {
+            visit(r * cols + c);
+        }
+    }
+}
+
+void EdgeIndex::segmentCandidates(const Point& a, const Point& b, std::vector<int>& out) const {
+    out.clear();
+    if (cellStart.empty()) return;
+    forEachCellOnSegment(a, b, [&](int cell) {
+        for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+            out.push_back((int)cellEdges[k]);
+        }
+    });
+    // Одно ребро может лежать в нескольких ячейках — убираем повторы
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void EdgeIndex::boxCandidates(const BoundingBox& query, std::vector<int>& out) const {
+    out.clear();
+    if (cellStart.empty() || !box.intersects(query)) return;
+    int colFrom = std::max(columnOf(query.minX) - 1, 0);
+    int colTo = std::min(columnOf(query.maxX) + 1, cols - 1);
+    int rowFrom = std::max(rowOf(query.minY) - 1, 0);
+    int rowTo = std::min(rowOf(query.maxY) + 1, rowCount - 1);
+    for (int r = rowFrom; r <= rowTo; ++r) {
+        for (int c = colFrom; c <= colTo; ++c) {
+            int cell = r * cols + c;
+            for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+                out.push_back((int)cellEdges[k]);
+            }
+        }
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
@@ -0,0 +1,84 @@
+﻿#pragma once
+
+#include "Geometry.h"
+#include "Point.h"
+#include "Polygon.h"
+#include <cstdint>
+#include <vector>
+
+/// \brief Пространственный индекс рёбер многоугольника — равномерная сетка над его ограничивающим прямоугольником.
+///
+/// Ребро i соединяет вершины i и (i + 1) % n. Каждой ячейке сетки сопоставлен список рёбер,
+/// проходящих через неё (в формате CSR: cellStart / cellEdges). Индекс позволяет проверять
+/// отрезок или прямоугольник не против всех n рёбер, а только против рёбер затронутых ячеек.
+/// После построения объект неизменяем, поэтому запросы можно выполнять из нескольких потоков.
+class EdgeIndex {
+public:
+    /// Пустой индекс (без рёбер)
+    EdgeIndex() = default;
+
+    /// \brief Строит индекс по вершинам многоугольника.
+    /// \param polygon      Многоугольник (вершины копируются, время жизни polygon не важно).
+    /// \param cellsPerAxis Число ячеек по каждой оси; 0 — подобрать автоматически (~sqrt(n)).
+    explicit EdgeIndex(const Polygon& polygon, int cellsPerAxis = 0);
+
+    /// Количество рёбер
+    int edgeCount() const { return (int)vertices.size(); }
+
+    /// Начало ребра i
+    const Point& edgeStart(int i) const { return vertices[i]; }
+
+    /// Конец ребра i
+    const Point& edgeEnd(int i) const { return vertices[(i + 1) % vertices.size()]; }
+
+    /// Ограничивающий прямоугольник сетки (совпадает с прямоугольником многоугольника)
+    const BoundingBox& bounds() const { return box; }
+
+    /// Число столбцов сетки
+    int columns() const { return cols; }
+
+    /// Число строк сетки
+    int rows() const { return rowCount; }
+
+    /// Ширина ячейки
+    float cellSizeX() const { return cellWidth; }
+
+    /// Высота ячейки
+    float cellSizeY() const { return cellHeight; }
+
+    /// \brief Собирает без повторов индексы рёбер из всех ячеек, через которые проходит отрезок [a,b].
+    /// \param[out] out Вектор кандидатов (очищается перед заполнением, индексы по возрастанию).
+    void segmentCandidates(const Point& a, const Point& b, std::vector<int>& out) const;
+
+    /// \brief Собирает без повторов индексы рёбер из всех ячеек, пересекающих прямоугольник query.
+    /// \param[out] out Вектор кандидатов (очищается перед заполнением, индексы по возрастанию).
+    void boxCandidates(const BoundingBox& query, std::vector<int>& out) const;
+
+    /// Начала списков рёбер по ячейкам (размер columns() * rows() + 1)
+    const std::vector<uint32_t>& cellStarts() const { return cellStart; }
+
+    /// Индексы рёбер, сгруппированные по ячейкам
+    const std::vector<uint32_t>& cellEdgeIds() const { return cellEdges; }
+
+private:
+    std::vector<Point> vertices;       // Копия вершин многоугольника
+    BoundingBox box;                   // Прямоугольник, покрываемый сеткой
+    int cols = 0;                      // Число столбцов
+    int rowCount = 0;                  // Число строк
+    float cellWidth = 1.0f;            // Ширина ячейки
+    float cellHeight = 1.0f;           // Высота ячейки
+    std::vector<uint32_t> cellStart;   // CSR: начало списка рёбер ячейки
+    std::vector<uint32_t> cellEdges;   // CSR: индексы рёбер
+
+    /// Номер столбца для координаты x (с ограничением диапазоном сетки)
+    int columnOf(double x) const;
+
+    /// Номер строки для координаты y (с ограничением диапазоном сетки)
+    int rowOf(double y) const;
+
+    /// \brief Вызывает visit(cellId) для каждой ячейки, через которую проходит отрезок [a,b].
+    /// \details Обход по строкам: в каждой строке берётся x-диапазон отрезка на высоте строки
+    ///          (с запасом в одну ячейку на погрешность), поэтому касание угла ячейки не теряется.
+    template <class Visitor>
+    void forEachCellOnSegment(const Point& a, const Point& b, Visitor visit) const;
+};
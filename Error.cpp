@@ -33,6 +33,7 @@ std::string Error::generateErrorMessage() const {
     case ErrorType::verticesMismatch:       typeStr = "verticesMismatch"; break;         //   
     case ErrorType::wrongOrder:             typeStr = "wrongOrder"; break;               //  
     case ErrorType::emptyFile:              typeStr = "emptyFile"; break;                //  
+    case ErrorType::invalidFileFormat:      typeStr = "invalidFileFormat"; break;        //    
     default:                                typeStr = "unknownError"; break;             //  
     }
 
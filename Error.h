@@ -18,7 +18,8 @@ enum class ErrorType {
     emptyLineFound,
     verticesMismatch,
     wrongOrder,
-    emptyFile
+    emptyFile,
+    invalidFileFormat
 };
 
 ///      
@@ -1,8 +1,13 @@
 #include "FileParser.h"
+#include "MappedFile.h"
 #include <fstream>
 #include <sstream>
 #include <cctype>
 #include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <algorithm>
 
 //     
 bool FileParser::readFromFile(const std::string& fileName, std::vector<Point>& vertices, Point& testPoint, Error& err) {
@@ -16,8 +21,39 @@ bool FileParser::readFromFile(const std::string& fileName, std::vector<Point>& v
         return false;  //  false,    
     }
 
-    std::string line;  //    ,   
     int lineNumber = 0;  //  
+    if (!readVertices(fin, vertices, lineNumber, err)) return false;  //     
+
+    std::string line;  //    ,   
+
+    //    
+    if (!std::getline(fin, line)) {
+        err.type = ErrorType::verticesMismatch;  //     
+        err.errorLineNumber = lineNumber + 1;  //    
+        err.errorMessage = "     .";  //   
+        return false;  //  false
+    }
+
+    ++lineNumber;  //   
+    float tx, ty;
+    if (!parsePointLine(line, tx, ty)) {  //    
+        err.type = ErrorType::pointNotInteger;  //    
+        err.errorLineNumber = lineNumber;  //    
+        err.errorMessage = "   .";  //   
+        return false;  //  false
+    }
+
+    // ,        
+    if (!checkOutOfRangeCoordinates(tx, ty, err, lineNumber, false)) return false;
+
+    testPoint = Point(tx, ty);  //   
+
+    return true;  //  true,     
+}
+
+//          
+bool FileParser::readVertices(std::istream& fin, std::vector<Point>& vertices, int& lineNumber, Error& err) {
+    std::string line;  //    ,   
 
     //    ( )
     if (!std::getline(fin, line)) {
@@ -91,29 +127,278 @@ bool FileParser::readFromFile(const std::string& fileName, std::vector<Point>& v
         vertices.emplace_back(x, y);  //    
     }
 
-    //    
-    if (!std::getline(fin, line)) {
-        err.type = ErrorType::verticesMismatch;  //     
-        err.errorLineNumber = lineNumber + 1;  //    
-        err.errorMessage = "     .";  //   
-        return false;  //  false
+    return true;  //       
+}
+
+//       (  )
+bool FileParser::readPointsFromFile(const std::string& fileName, std::vector<Point>& vertices, std::vector<Point>& points, Error& err) {
+    long long bodyOffset = 0;
+    int headerLines = 0;
+    if (!readPolygonHeader(fileName, vertices, bodyOffset, headerLines, err)) return false;
+
+    //        
+    MappedFile file;
+    points.clear();
+    if (!file.open(fileName, err)) return false;
+    const char* data = reinterpret_cast<const char*>(file.data());
+    size_t size = file.size();
+    size_t offset = std::min((size_t)bodyOffset, size);
+    if (!parsePoints(data + offset, size - offset, headerLines + 1, points, err)) return false;
+
+    //       
+    if (points.empty()) {
+        err.type = ErrorType::verticesMismatch;
+        err.errorLineNumber = headerLines + 1;
+        err.errorMessage = "     .";
+        return false;
     }
+    return true;
+}
 
-    ++lineNumber;  //   
-    float tx, ty;
-    if (!parsePointLine(line, tx, ty)) {  //    
-        err.type = ErrorType::pointNotInteger;  //    
-        err.errorLineNumber = lineNumber;  //    
-        err.errorMessage = "   .";  //   
-        return false;  //  false
+//   (N  )      
+bool FileParser::readPolygonHeader(const std::string& fileName, std::vector<Point>& vertices, long long& bodyOffset, int& headerLines, Error& err) {
+    std::ifstream fin(fileName);  //    
+    err.errorInputFileWay = fileName;
+
+    if (!fin.is_open()) {
+        err.type = ErrorType::inputFileNotExist;
+        err.errorMessage = "     . ,        .";
+        return false;
     }
 
-    // ,        
-    if (!checkOutOfRangeCoordinates(tx, ty, err, lineNumber, false)) return false;
+    headerLines = 0;
+    if (!readVertices(fin, vertices, headerLines, err)) return false;
 
-    testPoint = Point(tx, ty);  //   
+    std::streamoff offset = fin.tellg();  //       
+    if (offset < 0) {  //     
+        fin.clear();
+        fin.seekg(0, std::ios::end);
+        offset = fin.tellg();
+    }
+    bodyOffset = (long long)offset;
+    return true;
+}
 
-    return true;  //  true,     
+bool FileParser::readPolygonFromBuffer(const char* data, size_t size, std::vector<Point>& vertices, Error& err) {
+    std::istringstream in(std::string(data, size));  //    ,    
+    int lineNumber = 0;
+    return readVertices(in, vertices, lineNumber, err);
+}
+
+//   :  "N  "   
+bool FileParser::readPolygonLayer(const std::string& fileName, std::vector<std::vector<Point>>& polygons, std::vector<int>& firstLines, Error& err) {
+    std::ifstream fin(fileName);
+    err.errorInputFileWay = fileName;
+
+    if (!fin.is_open()) {
+        err.type = ErrorType::inputFileNotExist;
+        err.errorMessage = "     . ,        .";
+        return false;
+    }
+
+    polygons.clear();
+    firstLines.clear();
+    int lineNumber = 0;
+    while (fin.peek() != std::char_traits<char>::eof()) {
+        firstLines.push_back(lineNumber + 1);
+        polygons.emplace_back();
+        if (!readVertices(fin, polygons.back(), lineNumber, err)) return false;
+    }
+
+    if (polygons.empty()) {
+        err.type = ErrorType::emptyFile;
+        err.errorLineNumber = 0;
+        err.errorMessage = " ";
+        return false;
+    }
+    return true;
+}
+
+//       
+bool FileParser::streamPoints(const std::string& fileName, long long offset, int firstLine, size_t bufferBytes,
+    const std::function<bool(const Point* points, size_t count, uint64_t firstIndex)>& sink, Error& err) {
+    std::ifstream fin(fileName, std::ios::binary);
+    err.errorInputFileWay = fileName;
+
+    if (!fin.is_open()) {
+        err.type = ErrorType::inputFileNotExist;
+        err.errorMessage = "     . ,        .";
+        return false;
+    }
+    fin.seekg(offset);
+
+    bufferBytes = std::max<size_t>(bufferBytes, 64 * 1024);
+    std::vector<char> buffer(bufferBytes);
+    std::vector<Point> points;
+    points.reserve(bufferBytes / 8);  //      4  ("0;0\n"),     
+    uint64_t delivered = 0;           //      sink
+    int lineNumber = firstLine - 1;
+    size_t carry = 0;                 //    ,    
+
+    for (;;) {
+        fin.read(buffer.data() + carry, (std::streamsize)(buffer.size() - carry));
+        size_t filled = carry + (size_t)fin.gcount();
+        bool last = filled < buffer.size();  //     
+        if (filled == 0) break;
+
+        //     ;    
+        const char* data = buffer.data();
+        size_t begin = filled;  //       
+        if (!last) {
+            while (begin > 0 && data[begin - 1] != '\n') --begin;
+        }
+        if (!parsePoints(data, begin, lineNumber + 1, points, err)) return false;
+        lineNumber += (int)points.size();
+
+        if (!points.empty()) {
+            if (!sink(points.data(), points.size(), delivered)) return true;
+            delivered += points.size();
+            points.clear();
+        }
+        if (last) break;
+
+        carry = filled - std::min(begin, filled);
+        if (carry == buffer.size()) {  //        
+            err.type = ErrorType::invalidCharacters;
+            err.errorLineNumber = lineNumber + 1;
+            err.errorMessage = "     .";
+            return false;
+        }
+        std::memmove(buffer.data(), buffer.data() + begin, carry);
+    }
+    return true;
+}
+
+//    :    ,   
+bool FileParser::parsePoints(const char* data, size_t size, int firstLine, std::vector<Point>& points, Error& err, int threads) {
+    if (threads <= 0) {
+        threads = size >= ((size_t)1 << 20) ? std::max(1, (int)std::thread::hardware_concurrency()) : 1;
+    }
+
+    //        ,    
+    std::vector<size_t> bounds(1, 0);
+    for (int k = 1; k < threads; ++k) {
+        size_t at = std::max(size * k / threads, bounds.back());
+        const char* newline = at < size ? static_cast<const char*>(std::memchr(data + at, '\n', size - at)) : nullptr;
+        at = newline != nullptr ? (size_t)(newline - data) + 1 : size;
+        if (at > bounds.back() && at < size) bounds.push_back(at);
+    }
+    bounds.push_back(size);
+    size_t ranges = bounds.size() - 1;
+
+    auto forEachRange = [&](auto body) {
+        if (ranges == 1) {
+            body(0);
+            return;
+        }
+        std::vector<std::thread> workers;
+        for (size_t r = 0; r < ranges; ++r) workers.emplace_back(body, r);
+        for (std::thread& worker : workers) worker.join();
+    };
+
+    // 1)   :          
+    std::vector<size_t> lines(ranges + 1, 0);
+    forEachRange([&](size_t r) {
+        const char* from = data + bounds[r];
+        const char* to = data + bounds[r + 1];
+        size_t count = (size_t)std::count(from, to, '\n');
+        if (r + 1 == ranges && to > from && to[-1] != '\n') ++count;
+        lines[r + 1] = count;
+    });
+    for (size_t r = 0; r < ranges; ++r) lines[r + 1] += lines[r];  //  lines[r]     r
+
+    // 2) :       ,    
+    points.resize(lines[ranges]);
+    std::vector<Error> errors(ranges);
+    std::vector<char> failed(ranges, 0);
+    forEachRange([&](size_t r) {
+        const char* p = data + bounds[r];
+        const char* end = data + bounds[r + 1];
+        size_t index = lines[r];
+        int line = firstLine + (int)lines[r];
+        while (p < end) {
+            const char* newline = static_cast<const char*>(std::memchr(p, '\n', (size_t)(end - p)));
+            const char* lineEnd = newline != nullptr ? newline : end;
+            if (!parseQueryLine(p, lineEnd, points[index], errors[r], line)) {
+                failed[r] = 1;
+                return;
+            }
+            ++index;
+            ++line;
+            p = newline != nullptr ? newline + 1 : end;
+        }
+    });
+
+    //    :      
+    for (size_t r = 0; r < ranges; ++r) {
+        if (failed[r]) {
+            std::string fileWay = err.errorInputFileWay;
+            err = errors[r];
+            if (err.errorInputFileWay.empty()) err.errorInputFileWay = fileWay;
+            return false;
+        }
+    }
+    return true;
+}
+
+//     "x;y"   
+bool FileParser::parseQueryLine(const char* begin, const char* end, Point& p, Error& err, int lineNumber) {
+    if (end > begin && end[-1] == '\r') --end;  //    Windows (CRLF)
+
+    //      err (    )
+    auto fail = [&](ErrorType type, const char* message) {
+        err.type = type;
+        err.errorLineNumber = lineNumber;
+        err.errorLineContent.assign(begin, end);
+        err.errorMessage = message;
+        return false;
+    };
+
+    if (begin == end) {
+        return fail(ErrorType::emptyLineFound, "     .   .");
+    }
+
+    const char* sep = nullptr;  //   ';'
+    int separators = 0;
+    for (const char* c = begin; c != end; ++c) {
+        if (*c == ';') {
+            sep = c;
+            ++separators;
+        }
+        else if (!(std::isdigit(static_cast<unsigned char>(*c)) || *c == '-' || *c == '+' || *c == '.')) {
+            return fail(ErrorType::invalidCharacters, "    .   ,      .");
+        }
+    }
+    if (separators != 1) {
+        return fail(ErrorType::wrongElementCountInLine, "    .      ,  ;.");
+    }
+
+    // strtof           
+    float coords[2];
+    const char* starts[2] = { begin, sep + 1 };
+    const char* ends[2] = { sep, end };
+    for (int k = 0; k < 2; ++k) {
+        const char* from = starts[k];
+        const char* to = ends[k];
+        char buffer[64];
+        size_t length = (size_t)(to - from);
+        if (length == 0 || length >= sizeof(buffer)) {
+            return fail(ErrorType::pointNotInteger, "         .");
+        }
+        for (size_t i = 0; i < length; ++i) buffer[i] = from[i];
+        buffer[length] = '\0';
+        char* parsedEnd = nullptr;
+        coords[k] = std::strtof(buffer, &parsedEnd);
+        if (parsedEnd != buffer + length) {
+            return fail(ErrorType::pointNotInteger, "         .");
+        }
+    }
+
+    if (coords[0] < -999.0f || coords[0] > 999.0f || coords[1] < -999.0f || coords[1] > 999.0f) {
+        return fail(ErrorType::pointOutOfRange, "      [-999, 999].");
+    }
+    p = Point(coords[0], coords[1]);
+    return true;
 }
 
 // ,    
@@ -2,6 +2,9 @@
 
 #include "Error.h"
 #include "Point.h"
+#include <cstdint>
+#include <functional>
+#include <istream>
 #include <string>
 #include <vector>
 
@@ -23,9 +26,101 @@ public:
         Point& testPoint,
         Error& err);
 
+    /// \brief Считывает многоугольник и последовательность проверяемых точек (например, GPS-трек).
+    /// \details Формат совпадает с readFromFile(), но после N вершин следует одна или более строк "x;y"
+    ///          до конца файла — по одной проверяемой точке на строку. Строки точек отображаются в память
+    ///          и разбираются параллельно (parsePoints).
+    /// \param[in]   fileName – путь к входному файлу.
+    /// \param[out]  vertices – вектор вершин многоугольника (если успешно).
+    /// \param[out]  points   – проверяемые точки в порядке следования в файле.
+    /// \param[out]  err      – объект Error, куда записываются сведения об ошибках.
+    /// \return true, если файл прочитан и синтаксически корректен; false — при первой найденной ошибке.
+    bool readPointsFromFile(const std::string& fileName,
+        std::vector<Point>& vertices,
+        std::vector<Point>& points,
+        Error& err);
+
+    /// \brief Считывает только количество вершин и вершины; строки точек оставляет потоковым читателям.
+    /// \param[in]   fileName    – путь к входному файлу.
+    /// \param[out]  vertices    – вектор вершин многоугольника (если успешно).
+    /// \param[out]  bodyOffset  – смещение в байтах первой строки после вершин.
+    /// \param[out]  headerLines – число строк заголовка (N + 1); следующая строка имеет номер headerLines + 1.
+    /// \param[out]  err         – объект Error, куда записываются сведения об ошибках.
+    /// \return true, если заголовок прочитан и синтаксически корректен.
+    bool readPolygonHeader(const std::string& fileName,
+        std::vector<Point>& vertices,
+        long long& bodyOffset,
+        int& headerLines,
+        Error& err);
+
+    /// \brief Считывает количество вершин и вершины из буфера в памяти (формат как у входного файла).
+    /// \details Строки после вершин не читаются. Файлы и консоль не используются.
+    /// \param[in]   data     – начало буфера (может не завершаться нулём).
+    /// \param[in]   size     – размер буфера в байтах.
+    /// \param[out]  vertices – вектор вершин многоугольника (если успешно).
+    /// \param[out]  err      – объект Error, куда записываются сведения об ошибках.
+    /// \return true, если вершины прочитаны и синтаксически корректны.
+    bool readPolygonFromBuffer(const char* data, size_t size, std::vector<Point>& vertices, Error& err);
+
+    /// \brief Считывает слой многоугольников: блоки "N, N строк вершин" подряд до конца файла.
+    /// \param[in]   fileName   – путь к файлу слоя.
+    /// \param[out]  polygons   – вершины многоугольников в порядке файла.
+    /// \param[out]  firstLines – номер строки с N для каждого многоугольника (для сообщений валидации).
+    /// \param[out]  err        – объект Error, куда записываются сведения об ошибках.
+    /// \return true, если прочитан хотя бы один многоугольник и все блоки синтаксически корректны.
+    bool readPolygonLayer(const std::string& fileName,
+        std::vector<std::vector<Point>>& polygons,
+        std::vector<int>& firstLines,
+        Error& err);
+
+    /// \brief Потоково считывает строки точек "x;y" от позиции offset до конца файла.
+    /// \details Файл читается блоками по bufferBytes байт, точки передаются в sink порциями, поэтому
+    ///          расход памяти не зависит от размера файла. Строки разбираются parseQueryLine.
+    /// \param[in]   fileName    – путь к файлу точек.
+    /// \param[in]   offset      – смещение в байтах первой строки точек.
+    /// \param[in]   firstLine   – номер этой строки в файле (для сообщений об ошибках).
+    /// \param[in]   bufferBytes – размер блока чтения (не меньше 64 КиБ).
+    /// \param[in]   sink        – получает порцию точек и номер первой из них среди точек файла (с 0);
+    ///                            вернув false, прекращает чтение.
+    /// \param[out]  err         – объект Error, куда записываются сведения об ошибках.
+    /// \return true, если файл прочитан до конца или чтение прекращено sink; false — при ошибке.
+    bool streamPoints(const std::string& fileName,
+        long long offset,
+        int firstLine,
+        size_t bufferBytes,
+        const std::function<bool(const Point* points, size_t count, uint64_t firstIndex)>& sink,
+        Error& err);
+
+    /// \brief Разбирает строки точек "x;y" из буфера в памяти параллельно.
+    /// \details Буфер делится на диапазоны байтов, границы которых сдвинуты к началу строки. Сначала
+    ///          в каждом диапазоне считаются строки, и по сумме строк предыдущих диапазонов определяется
+    ///          номер его первой строки и место его точек в points; затем диапазоны разбираются
+    ///          parseQueryLine одновременно. Номер строки в ошибке — глобальный, как при
+    ///          последовательном разборе; если ошибок несколько, сообщается первая по порядку.
+    /// \param[in]   data      – начало строк точек (может не завершаться нулём).
+    /// \param[in]   size      – размер в байтах; завершающий перевод строки не даёт лишней пустой строки.
+    /// \param[in]   firstLine – номер первой строки в файле (для сообщений об ошибках).
+    /// \param[out]  points    – точки по порядку строк (при ошибке содержимое не определено).
+    /// \param[out]  err       – объект Error, куда записываются сведения об ошибке.
+    /// \param[in]   threads   – число потоков; 0 — по числу ядер для буферов от 1 МиБ, иначе один.
+    /// \return true, если все строки корректны.
+    static bool parsePoints(const char* data, size_t size, int firstLine, std::vector<Point>& points, Error& err, int threads = 0);
+
+    /// \brief Разбирает строку проверяемой точки "x;y" из диапазона [begin, end) без выделения памяти.
+    /// \details Завершающий '\r' отбрасывается. Ошибки: emptyLineFound, invalidCharacters,
+    ///          wrongElementCountInLine, pointNotInteger, pointOutOfRange.
+    /// \param[out] p          – разобранная точка (если успешно).
+    /// \param[out] err        – объект Error, куда записываются сведения об ошибке.
+    /// \param[in]  lineNumber – номер строки для сообщения об ошибке.
+    /// \return true, если строка корректна.
+    static bool parseQueryLine(const char* begin, const char* end, Point& p, Error& err, int lineNumber);
+
 private:
     // --- Вспомогательные private-методы для поэтапного синтаксического анализа ---
 
+    /// Чтение строки с количеством вершин и N строк с вершинами; lineNumber — номер последней прочитанной строки
+    bool readVertices(std::istream& fin, std::vector<Point>& vertices, int& lineNumber, Error& err);
+
     /// Проверка, что строка не пуста
     bool checkEmptyLine(const std::string& line, Error& err, int lineNumber);
 
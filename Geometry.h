@@ -0,0 +1,65 @@
+﻿#pragma once
+
+#include "Point.h"
+#include <algorithm>
+
+/// \brief Ограничивающий прямоугольник (bounding box), выровненный по осям.
+struct BoundingBox {
+    float minX = 0.0f;  // Левая граница
+    float minY = 0.0f;  // Нижняя граница
+    float maxX = 0.0f;  // Правая граница
+    float maxY = 0.0f;  // Верхняя граница
+
+    /// Проверка, что точка лежит внутри прямоугольника или на его границе
+    bool contains(const Point& p) const {
+        return p.x >= minX && p.x <= maxX && p.y >= minY && p.y <= maxY;
+    }
+
+    /// Проверка, что два прямоугольника имеют общую точку
+    bool intersects(const BoundingBox& other) const {
+        return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+    }
+
+    /// Расширяет прямоугольник так, чтобы он содержал точку p
+    void expand(const Point& p) {
+        minX = std::min(minX, p.x);
+        minY = std::min(minY, p.y);
+        maxX = std::max(maxX, p.x);
+        maxY = std::max(maxY, p.y);
+    }
+
+    /// Прямоугольник, построенный по одной точке
+    static BoundingBox fromPoint(const Point& p) {
+        BoundingBox box;
+        box.minX = box.maxX = p.x;
+        box.minY = box.maxY = p.y;
+        return box;
+    }
+
+    /// Прямоугольник отрезка [a,b]
+    static BoundingBox fromSegment(const Point& a, const Point& b) {
+        BoundingBox box = fromPoint(a);
+        box.expand(b);
+        return box;
+    }
+};
+
+/// \brief Векторное произведение (a - o) x (b - o) в double.
+/// \details В отличие от Polygon::orientation не усекает дробную часть координат.
+/// \return > 0 — поворот o→a→b против часовой стрелки, < 0 — по часовой, 0 — точки коллинеарны.
+inline double crossProduct(const Point& o, const Point& a, const Point& b) {
+    return ((double)a.x - o.x) * ((double)b.y - o.y) - ((double)a.y - o.y) * ((double)b.x - o.x);
+}
+
+/// Знак векторного произведения: -1, 0 или 1
+inline int crossSign(const Point& o, const Point& a, const Point& b) {
+    double c = crossProduct(o, a, b);
+    return (c > 0) - (c < 0);
+}
+
+/// \brief Проверка, что точка q лежит на отрезке [p,r] (включая концы).
+inline bool pointOnSegment(const Point& p, const Point& q, const Point& r) {
+    if (crossSign(p, r, q) != 0) return false;
+    return std::min(p.x, r.x) <= q.x && q.x <= std::max(p.x, r.x) &&
+        std::min(p.y, r.y) <= q.y && q.y <= std::max(p.y, r.y);
+}
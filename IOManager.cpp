@@ -1,28 +1,31 @@
 #include "IOManager.h"
-#include <fstream>
+#include "ResultWriter.h"
 #include <iostream>
 
 bool IOManager::writeResult(const std::string& fileName, bool result, Error& err) {
-    std::ofstream fout(fileName);  //    
-    err.errorOutputFileWay = fileName;  //       
-
-    // ,     
-    if (!fout.is_open()) {
-        err.type = ErrorType::outputFileCreateFail;  // ,    
-        err.errorMessage = "     . ,         .";  //   
+    ResultWriter writer;  //   : "" / " "
+    if (!writer.open(fileName, err)) {
         return false;  //  false,    
     }
+    writer.write(result);
+    return writer.close(err);
+}
 
-    //          result
-    if (result) {
-        fout << "\n";  //   true,  ""
+bool IOManager::writeResults(const std::string& fileName, const std::vector<bool>& results, Error& err) {
+    ResultWriter writer;
+    if (!writer.open(fileName, err)) {
+        return false;
     }
-    else {
-        fout << " \n";  //   false,  " "
+
+    //           
+    for (bool result : results) {
+        writer.write(result);
     }
+    return writer.close(err);
+}
 
-    fout.close();  //    
-    return true;  //  true,    
+const char* IOManager::resultText(bool result) {
+    return result ? "" : " ";
 }
 
 void IOManager::writeErrorToConsole(const Error& err) {
@@ -2,6 +2,7 @@
 
 #include "Error.h"
 #include <string>
+#include <vector>
 
 /// Класс IOManager содержит статические методы для записи результата и вывода ошибок в консоль.
 class IOManager {
@@ -13,6 +14,17 @@ public:
     /// \return true, если запись успешна; false — если файл не открылся.
     static bool writeResult(const std::string& fileName, bool result, Error& err);
 
+    /// \brief Записывает результаты для нескольких точек — по одной строке на точку.
+    /// \param[in]   fileName – путь к выходному файлу.
+    /// \param[in]   results  – results[i] = true → "принадлежит", false → "не принадлежит".
+    /// \param[out]  err      – объект Error для записи ошибок открытия/записи.
+    /// \return true, если запись успешна; false — если файл не открылся.
+    static bool writeResults(const std::string& fileName, const std::vector<bool>& results, Error& err);
+
+    /// \brief Текст результата в выходном файле (в той же кодировке, что и writeResult).
+    /// \param[in]   result   – true → "принадлежит", false → "не принадлежит".
+    static const char* resultText(bool result);
+
     /// \brief Выводит в консоль сообщение об ошибке из объекта Error.
     ///        Если err.type == noError, печатает "Ошибок не найдено".
     static void writeErrorToConsole(const Error& err);
@@ -0,0 +1,126 @@
+﻿#include "LatticeScanner.h"
+#include <algorithm>
+#include <cmath>
+
+LatticeScanner::LatticeScanner(const Polygon& polygon)
+    : vertices(polygon.vertices), box(polygon.boundingBox())
+{
+    int n = (int)vertices.size();
+    for (int i = 0; i < n; ++i) {
+        if (vertices[i].y != vertices[(i + 1) % n].y) edges.push_back(i);
+    }
+    std::sort(edges.begin(), edges.end(), [&](int l, int r) {
+        return std::min(vertices[l].y, vertices[(l + 1) % n].y) < std::min(vertices[r].y, vertices[(r + 1) % n].y);
+    });
+}
+
+void LatticeScanner::mergeSpans(std::vector<Span>& spans) {
+    std::sort(spans.begin(), spans.end(), [](const Span& l, const Span& r) { return l.left < r.left; });
+    size_t out = 0;
+    for (size_t i = 0; i < spans.size(); ++i) {
+        if (out > 0 && spans[i].left <= spans[out - 1].right) {
+            spans[out - 1].right = std::max(spans[out - 1].right, spans[i].right);
+        }
+        else {
+            spans[out++] = spans[i];
+        }
+    }
+    spans.resize(out);
+}
+
+long long LatticeScanner::integersIn(const Span& s) {
+    double from = std::ceil(s.left);
+    double to = std::floor(s.right);
+    return to >= from ? (long long)(to - from) + 1 : 0;
+}
+
+template <class Visitor>
+void LatticeScanner::scan(Visitor visit) const {
+    int n = (int)vertices.size();
+    if (n < 3) return;
+
+    auto lowY = [&](int e) { return std::min(vertices[e].y, vertices[(e + 1) % n].y); };
+    auto highY = [&](int e) { return std::max(vertices[e].y, vertices[(e + 1) % n].y); };
+
+    // Горизонтальные рёбра и вершины, лежащие на целых ординатах, — отрезки границы по строкам
+    struct RowExtra {
+        float y;
+        Span span;
+    };
+    std::vector<RowExtra> extras;
+    for (int i = 0; i < n; ++i) {
+        const Point& a = vertices[i];
+        const Point& b = vertices[(i + 1) % n];
+        if (a.y != std::floor(a.y)) continue;
+        extras.push_back({ a.y, { a.x, a.x } });
+        if (a.y == b.y) extras.push_back({ a.y, { std::min(a.x, b.x), std::max(a.x, b.x) } });
+    }
+    std::sort(extras.begin(), extras.end(), [](const RowExtra& l, const RowExtra& r) { return l.y < r.y; });
+
+    std::vector<int> active;
+    std::vector<double> xs;
+    std::vector<Span> covered;
+    std::vector<Span> boundary;
+    size_t nextEdge = 0;
+    size_t nextExtra = 0;
+    for (double y = std::ceil(box.minY); y <= box.maxY; y += 1.0) {
+        // Таблица активных рёбер: то же правило полуоткрытого интервала, что и в contains
+        while (nextEdge < edges.size() && lowY(edges[nextEdge]) <= y) {
+            active.push_back(edges[nextEdge++]);
+        }
+        active.erase(std::remove_if(active.begin(), active.end(), [&](int e) { return highY(e) <= y; }), active.end());
+
+        xs.clear();
+        boundary.clear();
+        for (int e : active) {
+            const Point& a = vertices[e];
+            const Point& b = vertices[(e + 1) % n];
+            // Числитель и знаменатель точны для целых координат, поэтому целое пересечение не теряется
+            double x = ((double)a.x * ((double)b.y - a.y) + (y - a.y) * ((double)b.x - a.x)) / ((double)b.y - a.y);
+            xs.push_back(x);
+            if (x == std::floor(x)) boundary.push_back({ x, x });
+        }
+        std::sort(xs.begin(), xs.end());
+        covered.clear();
+        for (size_t k = 0; k + 1 < xs.size(); k += 2) {
+            covered.push_back({ xs[k], xs[k + 1] });
+        }
+
+        while (nextExtra < extras.size() && extras[nextExtra].y < y) ++nextExtra;
+        for (size_t k = nextExtra; k < extras.size() && extras[k].y == y; ++k) {
+            covered.push_back(extras[k].span);
+            boundary.push_back(extras[k].span);
+        }
+
+        mergeSpans(covered);
+        mergeSpans(boundary);
+        visit(y, covered, boundary);
+    }
+}
+
+LatticeCount LatticeScanner::count() const {
+    LatticeCount result;
+    scan([&](double, const std::vector<Span>& covered, const std::vector<Span>& boundary) {
+        long long all = 0, onBoundary = 0;
+        for (const Span& s : covered) all += integersIn(s);
+        for (const Span& s : boundary) onBoundary += integersIn(s);
+        result.inside += all - onBoundary;
+        result.boundary += onBoundary;
+    });
+    return result;
+}
+
+void LatticeScanner::enumerate(std::vector<Point>& insidePoints, std::vector<Point>& boundaryPoints) const {
+    insidePoints.clear();
+    boundaryPoints.clear();
+    scan([&](double y, const std::vector<Span>& covered, const std::vector<Span>& boundary) {
+        size_t b = 0;  // Текущий отрезок границы (оба списка упорядочены)
+        for (const Span& s : covered) {
+            for (double x = std::ceil(s.left); x <= s.right; x += 1.0) {
+                while (b < boundary.size() && boundary[b].right < x) ++b;
+                bool onBoundary = b < boundary.size() && boundary[b].left <= x;
+                (onBoundary ? boundaryPoints : insidePoints).emplace_back((float)x, (float)y);
+            }
+        }
+    });
+}
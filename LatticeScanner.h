@@ -0,0 +1,57 @@
+﻿#pragma once
+
+#include "Point.h"
+#include "Polygon.h"
+#include <vector>
+
+/// \brief Количество точек целочисленной решётки в многоугольнике.
+struct LatticeCount {
+    long long inside = 0;    // Точки строго внутри
+    long long boundary = 0;  // Точки на границе (считаются принадлежащими, как в Polygon::contains)
+
+    /// Всего принадлежащих точек (внутри и на границе)
+    long long total() const { return inside + boundary; }
+};
+
+/// \brief Перечисление и подсчёт целочисленных точек многоугольника построчной развёрткой.
+///
+/// Для каждой целой ординаты y внутри ограничивающего прямоугольника пересечения горизонтали
+/// с активными рёбрами (таблица активных рёбер, упорядоченная по нижнему концу) сортируются
+/// и разбиваются на пары — отрезки «внутри». К ним добавляются горизонтальные рёбра и вершины
+/// на этой высоте, после чего целые точки каждого отрезка считаются или выводятся без вызова
+/// contains для каждой точки. Сложность — O(H·k·log k + результат), где k — число активных рёбер.
+class LatticeScanner {
+public:
+    /// \brief Подготавливает развёртку для многоугольника (вершины копируются).
+    explicit LatticeScanner(const Polygon& polygon);
+
+    /// \brief Подсчитывает целые точки внутри и на границе, не перечисляя их.
+    LatticeCount count() const;
+
+    /// \brief Перечисляет целые точки многоугольника построчно (снизу вверх, слева направо).
+    /// \param[out] insidePoints   Точки строго внутри.
+    /// \param[out] boundaryPoints Точки на границе.
+    void enumerate(std::vector<Point>& insidePoints, std::vector<Point>& boundaryPoints) const;
+
+private:
+    /// Отрезок [left, right] на строке развёртки
+    struct Span {
+        double left;
+        double right;
+    };
+
+    std::vector<Point> vertices;  // Копия вершин многоугольника
+    BoundingBox box;              // Ограничивающий прямоугольник
+    std::vector<int> edges;       // Негоризонтальные рёбра, упорядоченные по нижнему концу
+
+    /// \brief Обходит строки решётки; для каждой вызывает visit(y, covered, boundary), где covered —
+    ///        объединённые отрезки принадлежащих точек, boundary — объединённые отрезки границы.
+    template <class Visitor>
+    void scan(Visitor visit) const;
+
+    /// Сортирует и объединяет пересекающиеся отрезки
+    static void mergeSpans(std::vector<Span>& spans);
+
+    /// Количество целых чисел на отрезке [left, right]
+    static long long integersIn(const Span& s);
+};
@@ -0,0 +1,166 @@
+﻿#include "ManifestRunner.h"
+#include "FileParser.h"
+#include "IOManager.h"
+#include "Polygon.h"
+#include "ThreadPool.h"
+#include "Validator.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <new>
+
+namespace fs = std::filesystem;
+
+bool ManifestRunner::readManifest(const std::string& path, std::vector<ManifestEntry>& entries, Error& err) {
+    entries.clear();
+    std::error_code ec;
+
+    // Каталог: все *.txt по имени
+    if (fs::is_directory(path, ec)) {
+        for (const fs::directory_entry& file : fs::directory_iterator(path, ec)) {
+            if (file.is_regular_file(ec) && file.path().extension() == ".txt") {
+                entries.push_back({ file.path().string(), "" });
+            }
+        }
+        std::sort(entries.begin(), entries.end(),
+            [](const ManifestEntry& a, const ManifestEntry& b) { return a.input < b.input; });
+    }
+    else {
+        std::ifstream in(path);
+        if (!in.is_open()) {
+            err.type = ErrorType::inputFileNotExist;
+            err.errorInputFileWay = path;
+            return false;
+        }
+
+        // Относительные пути в манифесте отсчитываются от его каталога
+        fs::path base = fs::path(path).parent_path();
+        auto resolve = [&](const std::string& name) {
+            fs::path p(name);
+            return (p.is_relative() ? base / p : p).string();
+        };
+        auto trim = [](const std::string& s) {
+            size_t from = s.find_first_not_of(" \t\r");
+            size_t to = s.find_last_not_of(" \t\r");
+            return from == std::string::npos ? std::string() : s.substr(from, to - from + 1);
+        };
+
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(in, line)) {
+            ++lineNumber;
+            if (lineNumber == 1 && line.compare(0, 3, "\xEF\xBB\xBF") == 0) line.erase(0, 3);  // BOM
+            std::string text = trim(line);
+            if (text.empty() || text[0] == '#') continue;
+
+            ManifestEntry entry;
+            size_t sep = text.find(';');
+            entry.input = trim(text.substr(0, sep));
+            if (sep != std::string::npos) {
+                entry.output = trim(text.substr(sep + 1));
+                if (entry.output.empty() || entry.output.find(';') != std::string::npos) entry.input.clear();
+            }
+            if (entry.input.empty()) {
+                err.type = ErrorType::wrongElementCountInLine;
+                err.errorMessage = "ожидается \"вход\" или \"вход;выход\"";
+                err.errorLineNumber = lineNumber;
+                err.errorLineContent = line;
+                err.errorInputFileWay = path;
+                return false;
+            }
+            entry.input = resolve(entry.input);
+            if (!entry.output.empty()) entry.output = resolve(entry.output);
+            entries.push_back(entry);
+        }
+    }
+
+    if (entries.empty()) {
+        err.type = ErrorType::emptyFile;
+        err.errorMessage = "в манифесте нет входных файлов";
+        err.errorInputFileWay = path;
+        return false;
+    }
+    return true;
+}
+
+FileStatus ManifestRunner::checkFile(const ManifestEntry& entry) {
+    FileStatus status;
+    try {
+        // Те же шаги, что и в обычном режиме main
+        FileParser parser;
+        std::vector<Point> vertices;
+        Point testPoint;
+        if (!parser.readFromFile(entry.input, vertices, testPoint, status.err)) {
+            status.code = 2;
+            return status;
+        }
+
+        Validator validator;
+        if (!validator.validate(vertices, testPoint, status.err)) {
+            status.code = 3;
+            return status;
+        }
+
+        Polygon polygon(vertices);
+        if (!polygon.isValid(status.err)) {
+            status.code = 4;
+            return status;
+        }
+
+        status.result = polygon.contains(testPoint);
+
+        if (!entry.output.empty() && !IOManager::writeResult(entry.output, status.result, status.err)) {
+            status.code = 5;
+            return status;
+        }
+    }
+    catch (const std::bad_alloc&) {
+        // Один слишком большой файл не должен останавливать обработку остальных
+        status = FileStatus();
+        status.code = 2;
+        status.err.type = ErrorType::invalidVertexCount;
+        status.err.errorMessage = "недостаточно памяти";
+        status.err.errorInputFileWay = entry.input;
+    }
+    return status;
+}
+
+std::vector<FileStatus> ManifestRunner::run(const std::vector<ManifestEntry>& entries, int threads) {
+    std::vector<FileStatus> statuses(entries.size());
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    threads = std::max(1, std::min(threads, (int)entries.size()));
+
+    // Каждая задача пишет только в свой элемент statuses — синхронизация не нужна
+    ThreadPool pool(threads);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        pool.submit([&entries, &statuses, i]() { statuses[i] = checkFile(entries[i]); });
+    }
+    pool.wait();
+    return statuses;
+}
+
+std::string ManifestRunner::reportLine(const ManifestEntry& entry, const FileStatus& status) {
+    std::string line = entry.input + ";" + std::to_string(status.code) + ";";
+    line += status.code == 0 ? IOManager::resultText(status.result) : status.err.generateErrorMessage();
+    return line;
+}
+
+bool ManifestRunner::writeReport(const std::string& fileName, const std::vector<ManifestEntry>& entries,
+    const std::vector<FileStatus>& statuses, Error& err) {
+    std::ofstream out(fileName, std::ios::trunc);
+    if (!out.is_open()) {
+        err.type = ErrorType::outputFileCreateFail;
+        err.errorOutputFileWay = fileName;
+        return false;
+    }
+    for (size_t i = 0; i < entries.size() && i < statuses.size(); ++i) {
+        out << reportLine(entries[i], statuses[i]) << "\n";
+    }
+    out.flush();
+    if (!out) {
+        err.type = ErrorType::outputFileCreateFail;
+        err.errorOutputFileWay = fileName;
+        return false;
+    }
+    return true;
+}
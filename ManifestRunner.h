@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include "Error.h"
+#include <string>
+#include <vector>
+
+/// \brief Входной файл манифеста и необязательный выходной файл для него.
+struct ManifestEntry {
+    std::string input;   // Входной файл
+    std::string output;  // Выходной файл ("" — результат только в сводном отчёте)
+};
+
+/// \brief Итог обработки одного файла.
+struct FileStatus {
+    int code = 0;         // Код, как у завершения обычного режима: 0, 2, 3, 4 или 5
+    bool result = false;  // Принадлежит ли точка многоугольнику (при code == 0)
+    Error err;            // Сведения об ошибке (при code != 0)
+};
+
+/// \brief Обработка множества входных файлов в одном процессе на пуле потоков.
+///
+/// Каждый файл проверяется так же, как в обычном режиме (чтение, валидация, isValid, contains,
+/// запись результата), но ошибки не выводятся в консоль и не завершают программу, а становятся
+/// кодом в FileStatus. Итоги собираются в сводный отчёт в порядке манифеста.
+class ManifestRunner {
+public:
+    /// \brief Читает список файлов.
+    /// \details Если path — каталог, берутся все файлы *.txt в нём (по имени, без выходных файлов).
+    ///          Иначе path — текстовый файл: по строке "вход" или "вход;выход" на файл, пустые строки
+    ///          и строки, начинающиеся с '#', пропускаются. Относительные пути отсчитываются от
+    ///          каталога манифеста.
+    /// \param[out] err Объект ошибки (inputFileNotExist, emptyFile, wrongElementCountInLine).
+    static bool readManifest(const std::string& path, std::vector<ManifestEntry>& entries, Error& err);
+
+    /// \brief Проверяет один файл (шаги обычного режима) и записывает результат в entry.output, если задан.
+    static FileStatus checkFile(const ManifestEntry& entry);
+
+    /// \brief Проверяет все файлы на пуле потоков.
+    /// \param threads Число потоков; 0 — по числу ядер.
+    /// \return Итоги в порядке entries.
+    static std::vector<FileStatus> run(const std::vector<ManifestEntry>& entries, int threads = 0);
+
+    /// \brief Строка отчёта для файла: "вход;код;принадлежит|не принадлежит|сообщение об ошибке".
+    static std::string reportLine(const ManifestEntry& entry, const FileStatus& status);
+
+    /// \brief Записывает сводный отчёт — по строке reportLine на файл.
+    /// \param[out] err Объект ошибки (outputFileCreateFail).
+    static bool writeReport(const std::string& fileName, const std::vector<ManifestEntry>& entries,
+        const std::vector<FileStatus>& statuses, Error& err);
+};
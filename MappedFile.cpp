@@ -0,0 +1,75 @@
+﻿#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& fileName, Error& err) {
+    close();
+    err.errorInputFileWay = fileName;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping != nullptr) {
+                void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (view != nullptr) {
+                    fileHandle = file;
+                    mappingHandle = mapping;
+                    bytes = static_cast<const unsigned char*>(view);
+                    length = (size_t)fileSize.QuadPart;
+                    return true;
+                }
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+                ::close(fd);  // Отображение остаётся действительным и после закрытия дескриптора
+                bytes = static_cast<const unsigned char*>(view);
+                length = (size_t)st.st_size;
+                return true;
+            }
+        }
+        ::close(fd);
+    }
+#endif
+
+    err.type = ErrorType::inputFileNotExist;
+    err.errorMessage = "Не удалось отобразить файл в память. Возможно, файл не существует, пуст или нет прав на чтение.";
+    return false;
+}
+
+void MappedFile::close() {
+    if (bytes == nullptr) return;
+#ifdef _WIN32
+    UnmapViewOfFile(bytes);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(bytes), length);
+#endif
+    bytes = nullptr;
+    length = 0;
+}
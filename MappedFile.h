@@ -0,0 +1,41 @@
+﻿#pragma once
+
+#include "Error.h"
+#include <cstddef>
+#include <string>
+
+/// \brief Файл, отображённый в память только для чтения (mmap в POSIX, MapViewOfFile в Windows).
+///
+/// Используется для быстрой загрузки заранее подготовленных двоичных данных: содержимое
+/// не копируется, страницы подгружаются операционной системой по мере обращения.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// \brief Отображает файл в память целиком.
+    /// \param[in]  fileName Путь к файлу.
+    /// \param[out] err      Объект ошибки (inputFileNotExist, если файл не открыт или не отображён).
+    /// \return true, если файл отображён.
+    bool open(const std::string& fileName, Error& err);
+
+    /// Снимает отображение (повторный вызов безопасен)
+    void close();
+
+    /// Начало отображённых данных (nullptr, если файл не открыт или пуст)
+    const unsigned char* data() const { return bytes; }
+
+    /// Размер файла в байтах
+    size_t size() const { return length; }
+
+private:
+    const unsigned char* bytes = nullptr;  // Начало отображения
+    size_t length = 0;                     // Размер отображения
+#ifdef _WIN32
+    void* fileHandle = nullptr;            // HANDLE файла
+    void* mappingHandle = nullptr;         // HANDLE объекта отображения
+#endif
+};
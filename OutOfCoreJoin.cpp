@@ -0,0 +1,202 @@
+﻿#include "OutOfCoreJoin.h"
+#include "FileParser.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    // Запись точки во временном файле корзины
+    struct BucketRecord {
+        uint64_t index;  // Номер точки в файле (с 0)
+        float x;
+        float y;
+    };
+
+    // Обработка одной точки в корзине: запись, точка, ключ сортировки и пары SpatialJoin, с запасом
+    const size_t bytesPerJoinedPoint = 64;
+}
+
+OutOfCoreJoin::OutOfCoreJoin(const std::vector<Polygon>& polygons, const OutOfCoreOptions& options)
+    : polygons(polygons), options(options)
+{
+    this->options.memoryBudget = std::max<size_t>(this->options.memoryBudget, (size_t)1 << 20);
+    for (const Polygon& polygon : polygons) {
+        boxes.push_back(polygon.boundingBox());
+    }
+    if (!boxes.empty()) {
+        layerBox = boxes[0];
+        for (const BoundingBox& box : boxes) {
+            layerBox.expand(Point(box.minX, box.minY));
+            layerBox.expand(Point(box.maxX, box.maxY));
+        }
+    }
+}
+
+int OutOfCoreJoin::bucketOf(float x, float y) const {
+    float width = layerBox.maxX - layerBox.minX;
+    float height = layerBox.maxY - layerBox.minY;
+    int c = width > 0 ? (int)std::floor(((double)x - layerBox.minX) / width * bucketCols) : 0;
+    int r = height > 0 ? (int)std::floor(((double)y - layerBox.minY) / height * bucketRows) : 0;
+    c = std::min(std::max(c, 0), bucketCols - 1);
+    r = std::min(std::max(r, 0), bucketRows - 1);
+    return r * bucketCols + c;
+}
+
+bool OutOfCoreJoin::run(const std::string& pointsFile, const std::string& outputFile, JoinStats& stats, Error& err) {
+    auto started = std::chrono::steady_clock::now();
+    stats = JoinStats();
+    peakBytes = 0;
+    namespace fs = std::filesystem;
+    std::error_code ec;
+
+    // Число корзин: чтобы точки одной корзины (~16 байт записи на ~10 байт текста) обрабатывались одной порцией
+    int perAxis = options.bucketsPerAxis;
+    if (perAxis <= 0) {
+        double fileBytes = (double)fs::file_size(pointsFile, ec);
+        if (ec) fileBytes = 0;
+        double buckets = fileBytes / 10.0 * bytesPerJoinedPoint / (double)options.memoryBudget;
+        perAxis = (int)std::ceil(std::sqrt(std::max(buckets, 1.0)));
+    }
+    bucketCols = bucketRows = std::min(std::max(perAxis, 1), 16);
+    int buckets = bucketCols * bucketRows;
+
+    std::ofstream out(outputFile, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        err.type = ErrorType::outputFileCreateFail;
+        err.errorOutputFileWay = outputFile;
+        err.errorMessage = "Не удалось создать выходной файл.";
+        return false;
+    }
+
+    // Временные файлы корзин открываются при первой записи и удаляются при выходе из run
+    fs::path tempDir = options.tempDirectory.empty() ? fs::path(outputFile).parent_path() : fs::path(options.tempDirectory);
+    std::vector<std::string> bucketPaths(buckets);
+    std::vector<FILE*> bucketFiles(buckets, nullptr);
+    std::vector<uint64_t> bucketCounts(buckets, 0);
+    for (int b = 0; b < buckets; ++b) {
+        bucketPaths[b] = (tempDir / (fs::path(outputFile).filename().string() + ".bucket" + std::to_string(b) + ".tmp")).string();
+    }
+    struct Cleanup {
+        std::vector<FILE*>& files;
+        std::vector<std::string>& paths;
+        ~Cleanup() {
+            for (size_t b = 0; b < files.size(); ++b) {
+                if (files[b]) {
+                    std::fclose(files[b]);
+                    std::remove(paths[b].c_str());
+                }
+            }
+        }
+    } cleanup{ bucketFiles, bucketPaths };
+    auto tempFail = [&](int b) {
+        err.type = ErrorType::outputFileCreateFail;
+        err.errorOutputFileWay = bucketPaths[b];
+        err.errorMessage = "Не удалось записать временный файл корзины.";
+        return false;
+    };
+
+    // 1) Разбиение: буферы корзин занимают не больше половины бюджета, при заполнении сбрасываются на диск
+    size_t blockBytes = std::min<size_t>(options.memoryBudget / 4, (size_t)4 << 20);
+    size_t bufferLimit = std::max<size_t>(options.memoryBudget / 2 - blockBytes, 1 << 16) / sizeof(BucketRecord);
+    std::vector<std::vector<BucketRecord>> pending(buckets);
+    size_t pendingCount = 0;
+    bool writeFailed = false;
+    int failedBucket = 0;
+    auto flush = [&]() {
+        for (int b = 0; b < buckets && !writeFailed; ++b) {
+            if (pending[b].empty()) continue;
+            if (!bucketFiles[b]) bucketFiles[b] = std::fopen(bucketPaths[b].c_str(), "w+b");
+            if (!bucketFiles[b] || std::fwrite(pending[b].data(), sizeof(BucketRecord), pending[b].size(), bucketFiles[b]) != pending[b].size()) {
+                writeFailed = true;
+                failedBucket = b;
+            }
+            pending[b].clear();
+        }
+        pendingCount = 0;
+    };
+
+    FileParser parser;
+    bool parsed = parser.streamPoints(pointsFile, 0, 1, blockBytes,
+        [&](const Point* points, size_t count, uint64_t firstIndex) {
+            for (size_t i = 0; i < count; ++i) {
+                const Point& p = points[i];
+                if (boxes.empty() || !layerBox.contains(p)) continue;  // Вне слоя — совпадений нет
+                int b = bucketOf(p.x, p.y);
+                pending[b].push_back({ firstIndex + i, p.x, p.y });
+                ++bucketCounts[b];
+                if (++pendingCount >= bufferLimit) {
+                    peakBytes = std::max(peakBytes, blockBytes + pendingCount * sizeof(BucketRecord));
+                    flush();
+                }
+            }
+            stats.points += count;
+            return !writeFailed;
+        }, err);
+    if (!parsed) return false;
+    peakBytes = std::max(peakBytes, blockBytes + pendingCount * sizeof(BucketRecord));
+    flush();
+    if (writeFailed) return tempFail(failedBucket);
+    pending.clear();
+    pending.shrink_to_fit();
+
+    // 2) Корзины по одной: индекс только по задевающим корзину многоугольникам, точки порциями
+    size_t chunkPoints = std::max<size_t>(options.memoryBudget / bytesPerJoinedPoint, 1024);
+    std::vector<BucketRecord> records;
+    std::vector<Point> points;
+    JoinResult result;
+    for (int b = 0; b < buckets; ++b) {
+        if (bucketCounts[b] == 0) continue;
+
+        std::vector<Polygon> local;
+        std::vector<int> localIds;  // Номер в слое для локального номера многоугольника
+        for (size_t id = 0; id < polygons.size(); ++id) {
+            // Диапазон корзин прямоугольника — та же функция bucketOf, что и для точек
+            int from = bucketOf(boxes[id].minX, boxes[id].minY);
+            int to = bucketOf(boxes[id].maxX, boxes[id].maxY);
+            int col = b % bucketCols, row = b / bucketCols;
+            if (col < from % bucketCols || col > to % bucketCols || row < from / bucketCols || row > to / bucketCols) continue;
+            local.push_back(polygons[id]);
+            localIds.push_back((int)id);
+        }
+        if (local.empty()) continue;
+        SpatialJoin join(local);
+
+        std::rewind(bucketFiles[b]);
+        for (uint64_t done = 0; done < bucketCounts[b];) {
+            size_t count = (size_t)std::min<uint64_t>(chunkPoints, bucketCounts[b] - done);
+            records.resize(count);
+            if (std::fread(records.data(), sizeof(BucketRecord), count, bucketFiles[b]) != count) return tempFail(b);
+            points.resize(count);
+            for (size_t i = 0; i < count; ++i) points[i] = Point(records[i].x, records[i].y);
+            peakBytes = std::max(peakBytes, count * bytesPerJoinedPoint);
+
+            JoinStats chunkStats;
+            join.join(points, result, chunkStats);
+            stats.containsCalls += chunkStats.containsCalls;
+            stats.matches += chunkStats.matches;
+            for (size_t i = 0; i < count; ++i) {
+                for (size_t k = result.offsets[i]; k < result.offsets[i + 1]; ++k) {
+                    out << records[i].index << ';' << localIds[result.polygonIds[k]] << '\n';
+                }
+            }
+            done += count;
+        }
+        std::fclose(bucketFiles[b]);
+        bucketFiles[b] = nullptr;
+        std::remove(bucketPaths[b].c_str());
+    }
+
+    out.flush();
+    if (!out) {
+        err.type = ErrorType::outputFileCreateFail;
+        err.errorOutputFileWay = outputFile;
+        err.errorMessage = "Не удалось записать выходной файл.";
+        return false;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return true;
+}
@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include "Error.h"
+#include "Geometry.h"
+#include "Point.h"
+#include "Polygon.h"
+#include "SpatialJoin.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// \brief Настройки внешнего (out-of-core) соединения.
+struct OutOfCoreOptions {
+    size_t memoryBudget = (size_t)256 << 20;  // Бюджет памяти на буферы точек, байт (не меньше 1 МиБ)
+    std::string tempDirectory;                // Каталог файлов корзин; "" — каталог выходного файла
+    int bucketsPerAxis = 0;                   // Корзин по каждой оси (не больше 16); 0 — по размеру файла и бюджету
+};
+
+/// \brief Пространственное соединение файла точек, не помещающегося в память, со слоем многоугольников.
+///
+/// Первый проход читает файл точек потоково (FileParser::streamPoints) и раскладывает точки по
+/// корзинам — ячейкам сетки над прямоугольником слоя — во временные двоичные файлы. Второй проход
+/// обрабатывает корзины по одной: строится SpatialJoin только по многоугольникам, прямоугольники
+/// которых задевают корзину, и её точки проверяются порциями через Polygon::contains. Память
+/// ограничена бюджетом в обоих проходах, а файлы читаются и пишутся последовательно крупными блоками.
+class OutOfCoreJoin {
+public:
+    /// \brief Запоминает слой многоугольников и настройки.
+    /// \param polygons Валидные многоугольники слоя (копируются).
+    explicit OutOfCoreJoin(const std::vector<Polygon>& polygons, const OutOfCoreOptions& options = OutOfCoreOptions());
+
+    /// \brief Соединяет точки файла со слоем.
+    /// \details В выходной файл записывается по строке "номер точки;номер многоугольника" (оба с 0) на каждую
+    ///          пару, где точка принадлежит многоугольнику. Строки сгруппированы по корзинам, внутри корзины —
+    ///          по возрастанию номера точки. Временные файлы удаляются в любом случае.
+    /// \param[in]  pointsFile Файл точек: строки "x;y" до конца файла.
+    /// \param[out] stats      Статистика (точки, вызовы contains, совпадения, время).
+    /// \param[out] err        Объект ошибки (ошибки разбора точек, outputFileCreateFail).
+    /// \return true, если соединение выполнено.
+    bool run(const std::string& pointsFile, const std::string& outputFile, JoinStats& stats, Error& err);
+
+    /// Число корзин в последнем вызове run
+    int bucketCount() const { return bucketCols * bucketRows; }
+
+    /// Наибольший одновременно занятый объём буферов точек в последнем вызове run, байт
+    size_t peakBufferBytes() const { return peakBytes; }
+
+private:
+    std::vector<Polygon> polygons;     // Многоугольники слоя
+    std::vector<BoundingBox> boxes;    // Их ограничивающие прямоугольники
+    BoundingBox layerBox;              // Прямоугольник слоя
+    OutOfCoreOptions options;          // Настройки
+    int bucketCols = 1;                // Корзин по x
+    int bucketRows = 1;                // Корзин по y
+    size_t peakBytes = 0;              // Пик буферов последнего run
+
+    /// Номер корзины для точки (с ограничением диапазоном сетки)
+    int bucketOf(float x, float y) const;
+};
@@ -0,0 +1,115 @@
+﻿#include "PointIndex.h"
+#include "RasterMask.h"
+#include <algorithm>
+#include <cmath>
+
+PointIndex::PointIndex(const std::vector<Point>& source, int leafSize) {
+    if (source.empty()) return;
+    std::vector<IndexedPoint> items(source.size());
+    for (size_t i = 0; i < source.size(); ++i) items[i] = { source[i], (uint32_t)i };
+    build(items, 0, (uint32_t)items.size(), 0, std::max(1, leafSize));
+
+    points.resize(items.size());
+    ids.resize(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        points[i] = items[i].p;
+        ids[i] = items[i].id;
+    }
+}
+
+int PointIndex::build(std::vector<IndexedPoint>& items, uint32_t begin, uint32_t end, int depth, int leafSize) {
+    int index = (int)nodes.size();
+    nodes.push_back({ BoundingBox::fromPoint(items[begin].p), begin, end, -1, -1 });
+    for (uint32_t i = begin; i < end; ++i) nodes[index].box.expand(items[i].p);
+    if (end - begin <= (uint32_t)leafSize) return index;
+
+    // Деление по медиане вдоль оси, чередующейся с глубиной
+    uint32_t middle = begin + (end - begin) / 2;
+    bool byX = depth % 2 == 0;
+    std::nth_element(items.begin() + begin, items.begin() + middle, items.begin() + end,
+        [byX](const IndexedPoint& l, const IndexedPoint& r) { return byX ? l.p.x < r.p.x : l.p.y < r.p.y; });
+
+    int left = build(items, begin, middle, depth + 1, leafSize);
+    int right = build(items, middle, end, depth + 1, leafSize);
+    nodes[index].left = left;
+    nodes[index].right = right;
+    return index;
+}
+
+void PointIndex::query(const Polygon& polygon, std::vector<uint32_t>& result, PointQueryStats* stats, int cellsPerAxis) const {
+    result.clear();
+    PointQueryStats local;
+    if (nodes.empty() || polygon.vertices.empty()) {
+        if (stats) *stats = local;
+        return;
+    }
+
+    // Маска многоугольника и префиксные суммы внутренних и граничных ячеек
+    if (cellsPerAxis <= 0) {
+        cellsPerAxis = std::min(std::max(16, 4 * (int)std::ceil(std::sqrt((double)polygon.vertices.size()))), 512);
+    }
+    RasterMask mask(polygon, cellsPerAxis, cellsPerAxis);
+    const BoundingBox& box = mask.bounds();
+    int cols = mask.columns();
+    int rows = mask.rows();
+    double cellWidth = box.maxX > box.minX ? ((double)box.maxX - box.minX) / cols : 1.0;
+    double cellHeight = box.maxY > box.minY ? ((double)box.maxY - box.minY) / rows : 1.0;
+    size_t stride = (size_t)cols + 1;
+    std::vector<uint32_t> insideSum(stride * (rows + 1), 0);
+    std::vector<uint32_t> boundarySum(stride * (rows + 1), 0);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            MaskCell cell = mask.lookup(Point((float)(box.minX + (c + 0.5) * cellWidth), (float)(box.minY + (r + 0.5) * cellHeight)));
+            size_t at = (size_t)(r + 1) * stride + (c + 1);
+            insideSum[at] = insideSum[at - 1] + insideSum[at - stride] - insideSum[at - stride - 1] + (cell == MaskCell::inside);
+            boundarySum[at] = boundarySum[at - 1] + boundarySum[at - stride] - boundarySum[at - stride - 1] + (cell == MaskCell::boundary);
+        }
+    }
+    auto rectSum = [&](const std::vector<uint32_t>& sum, int c0, int r0, int c1, int r1) {
+        return sum[(size_t)(r1 + 1) * stride + (c1 + 1)] - sum[(size_t)r0 * stride + (c1 + 1)]
+            - sum[(size_t)(r1 + 1) * stride + c0] + sum[(size_t)r0 * stride + c0];
+    };
+
+    // Состояние прямоугольника узла по ячейкам маски; диапазон ячеек расширен на одну с каждой стороны
+    auto classify = [&](const BoundingBox& node) {
+        int c0 = std::max(0, (int)std::floor((node.minX - box.minX) / cellWidth) - 1);
+        int c1 = std::min(cols - 1, (int)std::floor((node.maxX - box.minX) / cellWidth) + 1);
+        int r0 = std::max(0, (int)std::floor((node.minY - box.minY) / cellHeight) - 1);
+        int r1 = std::min(rows - 1, (int)std::floor((node.maxY - box.minY) / cellHeight) + 1);
+        uint32_t cells = (uint32_t)((c1 - c0 + 1) * (r1 - r0 + 1));
+        uint32_t inside = rectSum(insideSum, c0, r0, c1, r1);
+        uint32_t boundary = rectSum(boundarySum, c0, r0, c1, r1);
+        bool withinBox = node.minX >= box.minX && node.maxX <= box.maxX && node.minY >= box.minY && node.maxY <= box.maxY;
+        if (withinBox && inside == cells) return MaskCell::inside;
+        if (inside == 0 && boundary == 0) return MaskCell::outside;
+        return MaskCell::boundary;
+    };
+
+    std::vector<int> stack(1, 0);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        ++local.nodesVisited;
+        if (!node.box.intersects(box)) continue;  // Вне прямоугольника многоугольника
+
+        MaskCell state = classify(node.box);
+        if (state == MaskCell::outside) continue;
+        if (state == MaskCell::inside) {
+            result.insert(result.end(), ids.begin() + node.begin, ids.begin() + node.end);
+            local.acceptedInBulk += node.end - node.begin;
+            continue;
+        }
+        if (node.left >= 0) {
+            stack.push_back(node.right);
+            stack.push_back(node.left);
+            continue;
+        }
+        // Лист на границе: каждая точка — по маске, в граничных ячейках — через contains
+        for (uint32_t i = node.begin; i < node.end; ++i) {
+            ++local.pointsTested;
+            if (mask.contains(points[i])) result.push_back(ids[i]);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    if (stats) *stats = local;
+}
@@ -0,0 +1,64 @@
+﻿#pragma once
+
+#include "Geometry.h"
+#include "Point.h"
+#include "Polygon.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \brief Статистика обратного запроса.
+struct PointQueryStats {
+    size_t nodesVisited = 0;    // Посещено узлов дерева
+    size_t acceptedInBulk = 0;  // Точек принято целыми поддеревьями (без проверки каждой точки)
+    size_t pointsTested = 0;    // Точек проверено по одной (по маске, граничные — через contains)
+};
+
+/// \brief Обратный запрос: индекс по неизменному набору точек, запросы — многоугольниками.
+///
+/// Точки один раз раскладываются в KD-дерево (деление пополам по медиане, чередуя оси). Для
+/// каждого многоугольника строится растровая маска (RasterMask) с таблицами префиксных сумм
+/// внутренних и граничных ячеек, поэтому прямоугольник любого узла классифицируется за O(1):
+/// поддеревья вне прямоугольника многоугольника или целиком во внешних ячейках отбрасываются,
+/// целиком во внутренних — принимаются без проверки точек, и только точки листьев на границе
+/// проверяются по маске и Polygon::contains. После построения объект неизменяем, запросы можно
+/// выполнять из нескольких потоков.
+class PointIndex {
+public:
+    /// \brief Строит дерево по точкам; номер точки — её индекс в points.
+    /// \param leafSize Наибольшее число точек в листе.
+    explicit PointIndex(const std::vector<Point>& points, int leafSize = 32);
+
+    /// \brief Находит точки, принадлежащие многоугольнику (граница считается принадлежащей).
+    /// \param[in]  polygon      Валидный многоугольник.
+    /// \param[out] ids          Номера точек по возрастанию.
+    /// \param[out] stats        Статистика (может быть nullptr).
+    /// \param      cellsPerAxis Размер маски по каждой оси; 0 — подобрать по числу вершин.
+    void query(const Polygon& polygon, std::vector<uint32_t>& ids, PointQueryStats* stats = nullptr, int cellsPerAxis = 0) const;
+
+    /// Количество точек
+    size_t size() const { return points.size(); }
+
+private:
+    /// Узел дерева: точки points[begin, end); у листа left == -1
+    struct Node {
+        BoundingBox box;  // Прямоугольник точек узла
+        uint32_t begin;   // Первая точка
+        uint32_t end;     // За последней точкой
+        int left;         // Левый потомок (-1 у листа)
+        int right;        // Правый потомок
+    };
+
+    /// Точка вместе с исходным номером — при построении переставляются вместе
+    struct IndexedPoint {
+        Point p;
+        uint32_t id;
+    };
+
+    std::vector<Point> points;  // Точки в порядке дерева
+    std::vector<uint32_t> ids;  // Исходные номера точек в том же порядке
+    std::vector<Node> nodes;    // Узлы; корень — nodes[0]
+
+    /// Строит поддерево для items[begin, end) и возвращает номер его узла
+    int build(std::vector<IndexedPoint>& items, uint32_t begin, uint32_t end, int depth, int leafSize);
+};
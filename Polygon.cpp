@@ -1,6 +1,10 @@
 #include "Polygon.h"
+#include <algorithm>
+#include <atomic>
 #include <climits>
+#include <cmath>
 #include <set> 
+#include <thread>
 
 // private:    ()   
 long long Polygon::signedArea() const {
@@ -55,6 +59,92 @@ bool Polygon::checkIntersection(const Point& a1, const Point& a2, const Point& b
     return false;  //   
 }
 
+bool Polygon::findSelfIntersection(int& first, int& second, int threads) const {
+    int n = (int)vertices.size();
+    if (n < 4) return false;  //     
+
+    //  64   ;      
+    if (threads <= 0) {
+        threads = n >= 20000 ? std::max(1, (int)std::thread::hardware_concurrency()) : 1;
+    }
+    int bands = std::min(std::max(1, n / 64), 4096);
+    BoundingBox box = boundingBox();
+    double bandHeight = (box.maxY > box.minY) ? ((double)box.maxY - box.minY) / bands : 1.0;
+    auto bandOf = [&](float y) {
+        int b = (int)std::floor(((double)y - box.minY) / bandHeight);
+        return std::min(std::max(b, 0), bands - 1);
+    };
+
+    //     (CSR).          
+    //  ,           .
+    std::vector<int> bandStart(bands + 1, 0);
+    for (int i = 0; i < n; ++i) {
+        const Point& a = vertices[i];
+        const Point& b = vertices[(i + 1) % n];
+        for (int k = bandOf(std::min(a.y, b.y)); k <= bandOf(std::max(a.y, b.y)); ++k) ++bandStart[k + 1];
+    }
+    for (int k = 0; k < bands; ++k) bandStart[k + 1] += bandStart[k];
+    std::vector<int> bandEdges(bandStart.back());
+    {
+        std::vector<int> fill(bandStart.begin(), bandStart.end() - 1);
+        for (int i = 0; i < n; ++i) {
+            const Point& a = vertices[i];
+            const Point& b = vertices[(i + 1) % n];
+            for (int k = bandOf(std::min(a.y, b.y)); k <= bandOf(std::max(a.y, b.y)); ++k) bandEdges[fill[k]++] = i;
+        }
+    }
+
+    //     (i, j), i < j,      (  i,   j)
+    auto searchBand = [&](int band, long long& best) {
+        std::vector<int> edges(bandEdges.begin() + bandStart[band], bandEdges.begin() + bandStart[band + 1]);
+        std::vector<BoundingBox> boxes(edges.size());
+        std::sort(edges.begin(), edges.end(), [&](int l, int r) {
+            return std::min(vertices[l].x, vertices[(l + 1) % n].x) < std::min(vertices[r].x, vertices[(r + 1) % n].x);
+        });
+        for (size_t k = 0; k < edges.size(); ++k) {
+            boxes[k] = BoundingBox::fromSegment(vertices[edges[k]], vertices[(edges[k] + 1) % n]);
+        }
+        for (size_t k = 0; k < edges.size(); ++k) {
+            // и    :     k   
+            for (size_t m = k + 1; m < edges.size() && boxes[m].minX <= boxes[k].maxX; ++m) {
+                if (!boxes[k].intersects(boxes[m])) continue;
+                int i = std::min(edges[k], edges[m]);
+                int j = std::max(edges[k], edges[m]);
+                if (j == i + 1 || (i == 0 && j == n - 1)) continue;  //   (  )
+                long long key = (long long)i * n + j;
+                if (key >= best) continue;  //      
+                if (checkIntersection(vertices[i], vertices[i + 1], vertices[j], vertices[(j + 1) % n])) {
+                    best = key;
+                }
+            }
+        }
+    };
+
+    const long long none = LLONG_MAX;
+    long long best = none;
+    if (threads == 1 || bands == 1) {
+        for (int band = 0; band < bands; ++band) searchBand(band, best);
+    }
+    else {
+        //      ;     , 
+        //      
+        std::atomic<int> nextBand(0);
+        std::vector<long long> found(threads, none);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                for (int band = nextBand++; band < bands; band = nextBand++) searchBand(band, found[t]);
+            });
+        }
+        for (std::thread& worker : workers) worker.join();
+        best = *std::min_element(found.begin(), found.end());
+    }
+    if (best == none) return false;
+    first = (int)(best / n);
+    second = (int)(best % n);
+    return true;
+}
+
 bool Polygon::checkPolygonShape(Error& err) const {
     int n = (int)vertices.size();  //    
 
@@ -75,23 +165,14 @@ bool Polygon::checkPolygonShape(Error& err) const {
     }
 
     // :   ( -    )
-    for (int i = 0; i < n; ++i) {
-        Point a1 = vertices[i];
-        Point a2 = vertices[(i + 1) % n];
-        for (int j = i + 2; j < n; ++j) {
-            if (j == i) continue;  //    ()
-            if (j == (i + 1) % n) continue;  //    (  )
-            if (i == 0 && j == n - 1) continue;  //      (  )
-            Point b1 = vertices[j];
-            Point b2 = vertices[(j + 1) % n];
-            if (checkIntersection(a1, a2, b1, b2)) {  //    
-                err.type = ErrorType::invalidPolygon;  // :  
-                err.errorLineNumber = j + 2;  //       
-                err.errorLineContent = std::to_string(b2.x) + ";" + std::to_string(b2.y);  //   
-                err.errorMessage = "    :  .";  //  
-                return false;  //  false    
-            }
-        }
+    int first = 0, second = 0;
+    if (findSelfIntersection(first, second)) {
+        const Point& b2 = vertices[(second + 1) % n];  //    
+        err.type = ErrorType::invalidPolygon;  // :  
+        err.errorLineNumber = second + 2;  //       
+        err.errorLineContent = std::to_string(b2.x) + ";" + std::to_string(b2.y);  //   
+        err.errorMessage = "    :  .";  //  
+        return false;  //  false    
     }
 
     //  :         
@@ -210,6 +291,202 @@ bool Polygon::contains(const Point& p) const {
     return inside;  //   : true  , false   
 }
 
+BoundingBox Polygon::boundingBox() const {
+    if (vertices.empty()) return BoundingBox();  //     
+    BoundingBox box = BoundingBox::fromPoint(vertices[0]);  //    
+    for (const Point& v : vertices) {
+        box.expand(v);  //    
+    }
+    return box;
+}
+
+template <class Visitor>
+bool Polygon::forEachEdgePair(const Polygon& other, Visitor visit) const {
+    int n = (int)vertices.size();
+    int m = (int)other.vertices.size();
+    if (n == 0 || m == 0) return false;
+    BoundingBox boxA = boundingBox();
+    BoundingBox boxB = other.boundingBox();
+    if (!boxA.intersects(boxB)) return false;
+
+    //            
+    BoundingBox overlap;
+    overlap.minX = std::max(boxA.minX, boxB.minX);
+    overlap.minY = std::max(boxA.minY, boxB.minY);
+    overlap.maxX = std::min(boxA.maxX, boxB.maxX);
+    overlap.maxY = std::min(boxA.maxY, boxB.maxY);
+
+    //   : 0..n-1    , n..n+m-1   other
+    std::vector<BoundingBox> boxes(n + m);
+    std::vector<int> edges;
+    for (int e = 0; e < n + m; ++e) {
+        const std::vector<Point>& v = e < n ? vertices : other.vertices;
+        int i = e < n ? e : e - n;
+        boxes[e] = BoundingBox::fromSegment(v[i], v[(i + 1) % v.size()]);
+        if (boxes[e].intersects(overlap)) edges.push_back(e);
+    }
+
+    //     ,  64    (  findSelfIntersection)
+    int bands = std::min(std::max(1, (int)edges.size() / 64), 4096);
+    double bandHeight = (overlap.maxY > overlap.minY) ? ((double)overlap.maxY - overlap.minY) / bands : 1.0;
+    auto bandOf = [&](float y) {
+        int b = (int)std::floor(((double)y - overlap.minY) / bandHeight);
+        return std::min(std::max(b, 0), bands - 1);
+    };
+    std::vector<int> bandStart(bands + 1, 0);
+    for (int e : edges) {
+        for (int k = bandOf(boxes[e].minY); k <= bandOf(boxes[e].maxY); ++k) ++bandStart[k + 1];
+    }
+    for (int k = 0; k < bands; ++k) bandStart[k + 1] += bandStart[k];
+    std::vector<int> bandEdges(bandStart.back());
+    {
+        std::vector<int> fill(bandStart.begin(), bandStart.end() - 1);
+        for (int e : edges) {
+            for (int k = bandOf(boxes[e].minY); k <= bandOf(boxes[e].maxY); ++k) bandEdges[fill[k]++] = e;
+        }
+    }
+
+    std::vector<int> band;
+    for (int k = 0; k < bands; ++k) {
+        band.assign(bandEdges.begin() + bandStart[k], bandEdges.begin() + bandStart[k + 1]);
+        std::sort(band.begin(), band.end(), [&](int l, int r) { return boxes[l].minX < boxes[r].minX; });
+        for (size_t a = 0; a < band.size(); ++a) {
+            // и    :     a   
+            for (size_t b = a + 1; b < band.size() && boxes[band[b]].minX <= boxes[band[a]].maxX; ++b) {
+                int e1 = band[a];
+                int e2 = band[b];
+                if ((e1 < n) == (e2 < n) || !boxes[e1].intersects(boxes[e2])) continue;  // и  
+                if (e1 < n ? visit(e1, e2 - n) : visit(e2, e1 - n)) return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool Polygon::intersects(const Polygon& other) const {
+    if (vertices.empty() || other.vertices.empty()) return false;
+    if (!boundingBox().intersects(other.boundingBox())) return false;
+
+    //   : ,     
+    int n = (int)vertices.size();
+    int m = (int)other.vertices.size();
+    bool touching = forEachEdgePair(other, [&](int i, int j) {
+        const Point& a0 = vertices[i];
+        const Point& a1 = vertices[(i + 1) % n];
+        const Point& b0 = other.vertices[j];
+        const Point& b1 = other.vertices[(j + 1) % m];
+        int s1 = crossSign(b0, b1, a0);
+        int s2 = crossSign(b0, b1, a1);
+        int s3 = crossSign(a0, a1, b0);
+        int s4 = crossSign(a0, a1, b1);
+        if (s1 * s2 < 0 && s3 * s4 < 0) return true;
+        return pointOnSegment(b0, a0, b1) || pointOnSegment(b0, a1, b1) ||
+            pointOnSegment(a0, b0, a1) || pointOnSegment(a0, b1, a1);
+    });
+    if (touching) return true;
+
+    //   :    ,     
+    return contains(other.vertices[0]) || other.contains(vertices[0]);
+}
+
+namespace {
+    //       :   
+    //         
+    struct BoundaryContact {
+        int edge;      //   
+        double t;      //   :   ( - )  ( - )
+        int vertex;    //        -1
+        int outerEdge; //   ,      ( vertex == -1)
+    };
+}
+
+bool Polygon::containsPolygon(const Polygon& other) const {
+    int n = (int)vertices.size();
+    int m = (int)other.vertices.size();
+    if (n == 0 || m == 0) return false;
+    BoundingBox outer = boundingBox();
+    BoundingBox inner = other.boundingBox();
+    if (inner.minX < outer.minX || inner.maxX > outer.maxX || inner.minY < outer.minY || inner.maxY > outer.maxY) {
+        return false;
+    }
+
+    //          ;      
+    double side = signedArea() < 0 ? -1.0 : 1.0;
+
+    std::vector<BoundaryContact> contacts;
+    bool crossing = forEachEdgePair(other, [&](int i, int j) {
+        const Point& a0 = vertices[i];
+        const Point& a1 = vertices[(i + 1) % n];
+        const Point& b0 = other.vertices[j];
+        const Point& b1 = other.vertices[(j + 1) % m];
+        int s1 = crossSign(b0, b1, a0);
+        int s2 = crossSign(b0, b1, a1);
+        int s3 = crossSign(a0, a1, b0);
+        int s4 = crossSign(a0, a1, b1);
+        if (s1 * s2 < 0 && s3 * s4 < 0) return true;  //  :   
+
+        double dx = (double)b1.x - b0.x;
+        double dy = (double)b1.y - b0.y;
+        auto position = [&](const Point& p) { return ((double)p.x - b0.x) * dx + ((double)p.y - b0.y) * dy; };
+        if (s1 == 0 && pointOnSegment(b0, a0, b1)) contacts.push_back({ j, position(a0), i, -1 });
+        if (s2 == 0 && pointOnSegment(b0, a1, b1)) contacts.push_back({ j, position(a1), (i + 1) % n, -1 });
+        bool b0Vertex = (b0.x == a0.x && b0.y == a0.y) || (b0.x == a1.x && b0.y == a1.y);
+        bool b1Vertex = (b1.x == a0.x && b1.y == a0.y) || (b1.x == a1.x && b1.y == a1.y);
+        if (s3 == 0 && !b0Vertex && pointOnSegment(a0, b0, a1)) contacts.push_back({ j, 0.0, -1, i });
+        if (s4 == 0 && !b1Vertex && pointOnSegment(a0, b1, a1)) contacts.push_back({ j, dx * dx + dy * dy, -1, i });
+        return false;
+    });
+    if (crossing) return false;
+
+    //   : other         
+    if (contacts.empty()) return contains(other.vertices[0]);
+
+    //    ,     c   (dx, dy),  
+    auto leavesInside = [&](const BoundaryContact& c, double dx, double dy) {
+        auto cross = [](double ux, double uy, double vx, double vy) { return ux * vy - uy * vx; };
+        if (c.vertex < 0) {
+            const Point& a0 = vertices[c.outerEdge];
+            const Point& a1 = vertices[(c.outerEdge + 1) % n];
+            return side * cross((double)a1.x - a0.x, (double)a1.y - a0.y, dx, dy) >= 0;
+        }
+        // :         
+        const Point& v = vertices[c.vertex];
+        const Point& prev = vertices[(c.vertex + (side > 0 ? n - 1 : 1)) % n];
+        const Point& next = vertices[(c.vertex + (side > 0 ? 1 : n - 1)) % n];
+        double px = (double)prev.x - v.x, py = (double)prev.y - v.y;
+        double qx = (double)next.x - v.x, qy = (double)next.y - v.y;
+        if (cross(-px, -py, qx, qy) >= 0) {  //   (  )
+            return cross(qx, qy, dx, dy) >= 0 && cross(dx, dy, px, py) >= 0;
+        }
+        //  :      () 
+        return !(cross(px, py, dx, dy) > 0 && cross(dx, dy, qx, qy) > 0);
+    };
+
+    std::sort(contacts.begin(), contacts.end(), [](const BoundaryContact& l, const BoundaryContact& r) {
+        return l.edge != r.edge ? l.edge < r.edge : l.t < r.t;
+    });
+    for (size_t from = 0; from < contacts.size();) {
+        size_t to = from;
+        while (to < contacts.size() && contacts[to].edge == contacts[from].edge) ++to;
+
+        //      ,   ,    ;
+        //        
+        int j = contacts[from].edge;
+        const Point& b0 = other.vertices[j];
+        const Point& b1 = other.vertices[(j + 1) % m];
+        double dx = (double)b1.x - b0.x;
+        double dy = (double)b1.y - b0.y;
+        double length = dx * dx + dy * dy;
+        if (contacts[from].t > 0 && !leavesInside(contacts[from], -dx, -dy)) return false;
+        for (size_t k = from; k < to; ++k) {
+            if (k + 1 < to && contacts[k + 1].t == contacts[k].t) continue;  //    
+            if (contacts[k].t < length && !leavesInside(contacts[k], dx, dy)) return false;
+        }
+        from = to;
+    }
+    return true;
+}
+
 Polygon::Polygon(const std::vector<Point>& v)
     : vertices(v)
 {
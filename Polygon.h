@@ -1,5 +1,6 @@
 #pragma once
 #include "Error.h"
+#include "Geometry.h"
 #include "Point.h"
 #include <vector>
 
@@ -31,6 +32,26 @@ public:
     /// \return true,       ; false    .
     bool contains(const Point& p) const;
 
+    /// \brief    .
+    /// \return     (    ).
+    BoundingBox boundingBox() const;
+
+    /// \brief ,        (  ).
+    /// \details    ,       
+    ///             (    x,   findSelfIntersection); 
+    ///            ,   contains ,      .
+    ///            O((n + m) log(n + m))        .
+    /// \return true,   ,     ;    false.
+    bool intersects(const Polygon& other) const;
+
+    /// \brief ,  other      (  ).
+    /// \details и other,    ,   false.  other,
+    ///           ,    (  )  ,
+    ///                   .   ,
+    ///             contains   other.
+    /// \return true,  other  (     );    false.
+    bool containsPolygon(const Polygon& other) const;
+
 ///private:
     /// \brief      (  ).
     /// \return  ;    .
@@ -53,10 +74,29 @@ public:
     /// \return 0  , 1   , 2    .
     int orientation(const Point& p, const Point& q, const Point& r) const;
 
+    /// \brief     ( i:  i  (i + 1) % n).
+    /// \details и    ,     
+    ///              checkIntersection;  
+    ///          .    ,     :   first,
+    ///                second.
+    /// \param[out] first, second      (first < second).
+    /// \param threads  ; 0        ( 20000 ),  .
+    /// \return true,   .
+    bool findSelfIntersection(int& first, int& second, int threads = 0) const;
+
     /// \brief  ,     .
     /// \param[out] err     .
     /// \return true,    .
     bool checkPolygonShape(Error& err) const;
+
+    /// \brief  visit(i, j)    i     j other,
+    ///           .
+    /// \details и         
+    ///                   .  
+    ///             . visit  true,   .
+    /// \return true,    visit.
+    template <class Visitor>
+    bool forEachEdgePair(const Polygon& other, Visitor visit) const;
 };
 
 
@@ -0,0 +1,107 @@
+﻿#include "PolygonApi.h"
+#include "Error.h"
+#include "FileParser.h"
+#include "Polygon.h"
+#include "Validator.h"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <new>
+
+struct PolygonHandle {
+    Polygon polygon;  // Многоугольник
+};
+
+namespace {
+
+/// Заполнение PolygonError по объекту Error
+int report(PolygonError* error, int status, const Error& err) {
+    if (error != nullptr) {
+        error->status = status;
+        error->type = (int)err.type;
+        error->line = err.errorLineNumber;
+        std::string text = status == POLYGON_OK ? std::string() : err.generateErrorMessage();
+        size_t length = std::min(text.size(), sizeof(error->message) - 1);
+        std::memcpy(error->message, text.data(), length);
+        error->message[length] = '\0';
+    }
+    return status;
+}
+
+/// Ошибка без объекта Error (неверный аргумент, исключение)
+int report(PolygonError* error, int status, const char* message) {
+    Error err;
+    err.errorMessage = message;
+    return report(error, status, err);
+}
+
+}
+
+extern "C" {
+
+PolygonHandle* polygon_create_from_buffer(const char* data, size_t size, PolygonError* error) {
+    if (data == nullptr && size > 0) {
+        report(error, POLYGON_ERROR_ARGUMENT, "data == NULL");
+        return nullptr;
+    }
+    try {
+        FileParser parser;
+        std::vector<Point> vertices;
+        Error err;
+        if (!parser.readPolygonFromBuffer(data, size, vertices, err)) {
+            report(error, POLYGON_ERROR_PARSE, err);
+            return nullptr;
+        }
+        PolygonHandle* handle = new PolygonHandle();
+        handle->polygon = Polygon(vertices);
+        report(error, POLYGON_OK, err);
+        return handle;
+    }
+    catch (const std::exception& e) {
+        report(error, POLYGON_ERROR_INTERNAL, e.what());
+        return nullptr;
+    }
+}
+
+int polygon_validate(PolygonHandle* polygon, PolygonError* error) {
+    if (polygon == nullptr) return report(error, POLYGON_ERROR_ARGUMENT, "polygon == NULL");
+    try {
+        Error err;
+        const std::vector<Point>& vertices = polygon->polygon.vertices;
+        Validator validator;
+        // Проверяемой точки нет — валидатору передаётся заведомо допустимая (первая вершина, если есть)
+        if (!validator.validate(vertices, vertices.empty() ? Point() : vertices.front(), err)) {
+            return report(error, POLYGON_ERROR_VALIDATION, err);
+        }
+        if (!polygon->polygon.isValid(err)) {
+            return report(error, POLYGON_ERROR_INVALID, err);
+        }
+        return report(error, POLYGON_OK, err);
+    }
+    catch (const std::exception& e) {
+        return report(error, POLYGON_ERROR_INTERNAL, e.what());
+    }
+}
+
+int polygon_contains(const PolygonHandle* polygon, float x, float y) {
+    if (polygon == nullptr) return -1;
+    return polygon->polygon.contains(Point(x, y)) ? 1 : 0;
+}
+
+int polygon_contains_batch(const PolygonHandle* polygon, const float* xy, size_t count, unsigned char* results) {
+    if (polygon == nullptr || (count > 0 && (xy == nullptr || results == nullptr))) return POLYGON_ERROR_ARGUMENT;
+    for (size_t i = 0; i < count; ++i) {
+        results[i] = polygon->polygon.contains(Point(xy[2 * i], xy[2 * i + 1])) ? 1 : 0;
+    }
+    return POLYGON_OK;
+}
+
+int polygon_vertex_count(const PolygonHandle* polygon) {
+    return polygon == nullptr ? -1 : (int)polygon->polygon.vertices.size();
+}
+
+void polygon_free(PolygonHandle* polygon) {
+    delete polygon;
+}
+
+}
@@ -0,0 +1,72 @@
+﻿#pragma once
+
+/* C-интерфейс библиотеки проверки принадлежности точки многоугольнику.
+ *
+ * Заголовок совместим с C и C++. Функции не обращаются к файлам и консоли и не выбрасывают
+ * исключений. Описатель многоугольника после создания неизменяем (кроме polygon_validate),
+ * поэтому polygon_contains и polygon_contains_batch можно вызывать из нескольких потоков. */
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#  if defined(POLYGON_API_EXPORTS)
+#    define POLYGON_API __declspec(dllexport)
+#  elif defined(POLYGON_API_SHARED)
+#    define POLYGON_API __declspec(dllimport)
+#  else
+#    define POLYGON_API
+#  endif
+#else
+#  define POLYGON_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Коды результата (совпадают с кодами завершения polygon.exe) */
+enum PolygonStatus {
+    POLYGON_OK = 0,                /* Успешно */
+    POLYGON_ERROR_ARGUMENT = 1,    /* Неверный аргумент (нулевой указатель и т. п.) */
+    POLYGON_ERROR_PARSE = 2,       /* Синтаксическая ошибка во входных данных */
+    POLYGON_ERROR_VALIDATION = 3,  /* Количество вершин или координаты вне допустимых пределов */
+    POLYGON_ERROR_INVALID = 4,     /* Некорректный многоугольник (порядок обхода, самопересечения и т. п.) */
+    POLYGON_ERROR_INTERNAL = 100   /* Внутренняя ошибка (например, нехватка памяти) */
+};
+
+/* Сведения об ошибке */
+typedef struct PolygonError {
+    int status;         /* PolygonStatus */
+    int type;           /* Значение ErrorType из Error.h */
+    int line;           /* Номер строки входных данных (0 — не относится к строке) */
+    char message[512];  /* Полное сообщение (Error::generateErrorMessage), усечённое, с завершающим нулём */
+} PolygonError;
+
+/* Непрозрачный описатель многоугольника */
+typedef struct PolygonHandle PolygonHandle;
+
+/* Создаёт многоугольник из буфера в формате входного файла (N и N строк "x;y"; строки после вершин
+ * не читаются). Буфер не обязан завершаться нулём и может быть освобождён после вызова.
+ * Возвращает NULL при ошибке; сведения — в error (может быть NULL). */
+POLYGON_API PolygonHandle* polygon_create_from_buffer(const char* data, size_t size, PolygonError* error);
+
+/* Проверяет многоугольник так же, как polygon.exe: пределы координат и числа вершин, затем
+ * корректность формы. Возвращает PolygonStatus; сведения — в error (может быть NULL). */
+POLYGON_API int polygon_validate(PolygonHandle* polygon, PolygonError* error);
+
+/* Принадлежность точки многоугольнику (граница принадлежит): 1 — да, 0 — нет, -1 — polygon == NULL. */
+POLYGON_API int polygon_contains(const PolygonHandle* polygon, float x, float y);
+
+/* Проверяет count точек; xy — пары координат (x0, y0, x1, y1, ...), results[i] = 1 или 0.
+ * Возвращает PolygonStatus. */
+POLYGON_API int polygon_contains_batch(const PolygonHandle* polygon, const float* xy, size_t count, unsigned char* results);
+
+/* Количество вершин (-1 — polygon == NULL) */
+POLYGON_API int polygon_vertex_count(const PolygonHandle* polygon);
+
+/* Освобождает многоугольник (NULL допускается) */
+POLYGON_API void polygon_free(PolygonHandle* polygon);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,104 @@
+﻿#include "PolygonCompiler.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+/// Литерал double, точно воспроизводящий значение координаты
+std::string literal(double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.17g", value);
+    std::string result = text;
+    if (result.find_first_of(".en") == std::string::npos) result += ".0";
+    return result;
+}
+
+/// Выражение (value - base) с подстановкой константы
+std::string shifted(const char* value, double base) {
+    if (base == 0.0) return value;
+    return std::string("(") + value + (base < 0 ? " + " : " - ") + literal(std::abs(base)) + ")";
+}
+
+}
+
+void PolygonCompiler::emitHeader(const Polygon& polygon, const std::string& name, const std::string& source, std::ostream& out) {
+    const std::vector<Point>& v = polygon.vertices;
+    int n = (int)v.size();
+
+    out << "#pragma once\n\n"
+        << "// Сгенерировано polygon.exe --compile из " << source << ". Не редактировать вручную.\n\n"
+        << "namespace " << name << " {\n\n"
+        << "constexpr int vertexCount = " << n << ";\n\n"
+        << "constexpr double vertices[vertexCount][2] = {\n";
+    for (int i = 0; i < n; ++i) {
+        out << "    { " << literal(v[i].x) << ", " << literal(v[i].y) << " },\n";
+    }
+    out << "};\n\n";
+
+    out << "/// Принадлежность точки (x, y) многоугольнику; граница принадлежит многоугольнику.\n"
+        << "constexpr bool contains(double x, double y) {\n"
+        << "    int inside = 0;    // Чётность числа пересечений луча вправо от точки\n"
+        << "    int boundary = 0;  // Точка лежит на одном из рёбер\n"
+        << "    double c = 0.0;    // Векторное произведение (b - a) x (p - a)\n";
+    for (int i = 0; i < n; ++i) {
+        const Point& a = v[i];
+        const Point& b = v[(i + 1) % n];
+        double dx = (double)b.x - a.x;
+        double dy = (double)b.y - a.y;
+        out << "\n    // Ребро " << i << ": (" << literal(a.x) << "; " << literal(a.y) << ") - ("
+            << literal(b.x) << "; " << literal(b.y) << ")\n";
+        out << "    c = " << literal(dx) << " * " << shifted("y", a.y) << " - " << literal(dy) << " * " << shifted("x", a.x) << ";\n";
+        out << "    boundary |= (c == 0.0) & (x >= " << literal(std::min(a.x, b.x)) << ") & (x <= " << literal(std::max(a.x, b.x))
+            << ") & (y >= " << literal(std::min(a.y, b.y)) << ") & (y <= " << literal(std::max(a.y, b.y)) << ");\n";
+        // Ребро пересекает луч, если y между концами (нижний включительно), а пересечение правее точки:
+        // x пересечения - x = c / dy, поэтому знак c сравнивается со знаком dy. Горизонтальные рёбра луч не пересекают.
+        if (dy > 0) {
+            out << "    inside ^= (y >= " << literal(a.y) << ") & (y < " << literal(b.y) << ") & (c > 0.0);\n";
+        }
+        else if (dy < 0) {
+            out << "    inside ^= (y >= " << literal(b.y) << ") & (y < " << literal(a.y) << ") & (c < 0.0);\n";
+        }
+    }
+    out << "\n    return (inside | boundary) != 0;\n"
+        << "}\n\n";
+
+    // Самопроверка при компиляции: вершины лежат на границе
+    for (int i = 0; i < std::min(n, 3); ++i) {
+        out << "static_assert(contains(vertices[" << i << "][0], vertices[" << i << "][1]), \"вершина лежит на границе\");\n";
+    }
+    out << "\n} // namespace " << name << "\n";
+}
+
+bool PolygonCompiler::compileToFile(const Polygon& polygon, const std::string& name, const std::string& source,
+    const std::string& outputPath, Error& err) {
+    std::ofstream fout(outputPath);
+    err.errorOutputFileWay = outputPath;
+    if (!fout.is_open()) {
+        err.type = ErrorType::outputFileCreateFail;
+        err.errorMessage = "Неверно указан файл для выходных данных. Возможно, указанного расположения не существует или нет прав на запись.";
+        return false;
+    }
+    emitHeader(polygon, name, source, fout);
+    fout.close();
+    if (!fout) {
+        err.type = ErrorType::outputFileCreateFail;
+        err.errorMessage = "Ошибка записи результатов в выходной файл.";
+        return false;
+    }
+    return true;
+}
+
+std::string PolygonCompiler::identifierFromPath(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string stem = path.substr(slash == std::string::npos ? 0 : slash + 1);
+    size_t dot = stem.find('.');
+    if (dot != std::string::npos) stem.erase(dot);
+    for (char& ch : stem) {
+        if (!std::isalnum((unsigned char)ch) && ch != '_') ch = '_';
+    }
+    if (stem.empty() || std::isdigit((unsigned char)stem[0])) stem.insert(stem.begin(), '_');
+    return stem;
+}
@@ -0,0 +1,32 @@
+﻿#pragma once
+
+#include "Error.h"
+#include "Polygon.h"
+#include <ostream>
+#include <string>
+
+/// \brief Генератор C++-заголовка со специализированной проверкой принадлежности для неизменяемого многоугольника.
+///
+/// Заголовок содержит пространство имён с constexpr-массивом вершин и функцией
+/// constexpr bool contains(double x, double y), в которой цикл по рёбрам полностью развёрнут,
+/// а коэффициенты каждого ребра подставлены константами. Проверки рёбер собираются побитовыми
+/// операциями без ветвлений. Граница считается принадлежащей многоугольнику, как в Polygon::contains;
+/// векторные произведения вычисляются в double без усечения, поэтому для целочисленных точек
+/// результат совпадает с Polygon::contains. Функцию можно использовать в static_assert.
+class PolygonCompiler {
+public:
+    /// \brief Записывает заголовок в поток.
+    /// \param polygon Валидный многоугольник.
+    /// \param name    Имя пространства имён (корректный идентификатор C++).
+    /// \param source  Путь к исходному файлу (для комментария в заголовке).
+    static void emitHeader(const Polygon& polygon, const std::string& name, const std::string& source, std::ostream& out);
+
+    /// \brief Записывает заголовок в файл outputPath.
+    /// \param[out] err Объект ошибки (outputFileCreateFail).
+    static bool compileToFile(const Polygon& polygon, const std::string& name, const std::string& source,
+        const std::string& outputPath, Error& err);
+
+    /// \brief Имя пространства имён по пути к файлу: имя файла без расширения, недопустимые символы
+    ///        заменяются на '_', перед ведущей цифрой добавляется '_'.
+    static std::string identifierFromPath(const std::string& path);
+};
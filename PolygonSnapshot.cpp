@@ -0,0 +1,207 @@
+﻿#include "PolygonSnapshot.h"
+#include "EdgeIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+/// Заголовок файла снимка (все смещения — от начала файла, кратны 8)
+struct SnapshotHeader {
+    char magic[8];             // "PPCSNAP"
+    uint32_t version;          // Версия формата
+    uint32_t headerSize;       // sizeof(SnapshotHeader)
+    uint32_t vertexCount;      // Число вершин
+    int32_t columns;           // Число столбцов сетки
+    int32_t rows;              // Число строк сетки
+    float minX, minY, maxX, maxY;  // Прямоугольник сетки
+    float cellWidth;           // Ширина ячейки
+    float cellHeight;          // Высота ячейки
+    uint32_t reserved;         // Выравнивание
+    uint64_t fingerprint;      // Отпечаток вершин (PolygonSnapshot::fingerprintOf)
+    uint64_t verticesOffset;   // Смещение массива вершин (пары float)
+    uint64_t cellStartOffset;  // Смещение массива начал списков (columns * rows + 1 значений uint32)
+    uint64_t cellEdgesOffset;  // Смещение массива индексов рёбер (uint32)
+    uint64_t cellEdgeCount;    // Число элементов в массиве индексов рёбер
+    uint64_t fileSize;         // Полный размер файла
+};
+
+const char kSnapshotMagic[8] = { 'P', 'P', 'C', 'S', 'N', 'A', 'P', '\0' };
+const uint32_t kSnapshotVersion = 1;
+
+/// Округление вверх до кратного 8
+uint64_t align8(uint64_t value) {
+    return (value + 7) & ~(uint64_t)7;
+}
+
+/// Запись нулевых байтов до смещения offset
+void padTo(std::ofstream& fout, uint64_t written, uint64_t offset) {
+    for (; written < offset; ++written) fout.put('\0');
+}
+
+}
+
+uint64_t PolygonSnapshot::fingerprintOf(const std::vector<Point>& vertices) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    uint32_t n = (uint32_t)vertices.size();
+    mix(&n, sizeof(n));
+    for (const Point& p : vertices) {
+        mix(&p.x, sizeof(float));
+        mix(&p.y, sizeof(float));
+    }
+    return hash;
+}
+
+bool PolygonSnapshot::write(const Polygon& polygon, const std::string& fileName, Error& err, int cellsPerAxis) {
+    err.errorOutputFileWay = fileName;
+    EdgeIndex index(polygon, cellsPerAxis);
+    const std::vector<uint32_t>& starts = index.cellStarts();
+    const std::vector<uint32_t>& edges = index.cellEdgeIds();
+
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+    header.version = kSnapshotVersion;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.vertexCount = (uint32_t)polygon.vertices.size();
+    header.columns = index.columns();
+    header.rows = index.rows();
+    header.minX = index.bounds().minX;
+    header.minY = index.bounds().minY;
+    header.maxX = index.bounds().maxX;
+    header.maxY = index.bounds().maxY;
+    header.cellWidth = index.cellSizeX();
+    header.cellHeight = index.cellSizeY();
+    header.fingerprint = fingerprintOf(polygon.vertices);
+    header.verticesOffset = align8(sizeof(SnapshotHeader));
+    header.cellStartOffset = align8(header.verticesOffset + (uint64_t)header.vertexCount * 2 * sizeof(float));
+    header.cellEdgesOffset = align8(header.cellStartOffset + (uint64_t)starts.size() * sizeof(uint32_t));
+    header.cellEdgeCount = edges.size();
+    header.fileSize = header.cellEdgesOffset + (uint64_t)edges.size() * sizeof(uint32_t);
+
+    std::ofstream fout(fileName, std::ios::binary);
+    if (!fout.is_open()) {
+        err.type = ErrorType::outputFileCreateFail;
+        err.errorMessage = "Не удалось создать файл снимка многоугольника.";
+        return false;
+    }
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    padTo(fout, sizeof(header), header.verticesOffset);
+    for (const Point& p : polygon.vertices) {
+        fout.write(reinterpret_cast<const char*>(&p.x), sizeof(float));
+        fout.write(reinterpret_cast<const char*>(&p.y), sizeof(float));
+    }
+    padTo(fout, header.verticesOffset + (uint64_t)header.vertexCount * 2 * sizeof(float), header.cellStartOffset);
+    fout.write(reinterpret_cast<const char*>(starts.data()), starts.size() * sizeof(uint32_t));
+    padTo(fout, header.cellStartOffset + (uint64_t)starts.size() * sizeof(uint32_t), header.cellEdgesOffset);
+    fout.write(reinterpret_cast<const char*>(edges.data()), edges.size() * sizeof(uint32_t));
+    if (!fout) {
+        err.type = ErrorType::outputFileCreateFail;
+        err.errorMessage = "Ошибка записи файла снимка многоугольника.";
+        return false;
+    }
+    return true;
+}
+
+bool PolygonSnapshot::open(const std::string& fileName, Error& err) {
+    std::unique_ptr<MappedFile> file(new MappedFile());
+    if (!file->open(fileName, err)) return false;
+
+    // Проверка заголовка и согласованности размеров до любого обращения к данным
+    SnapshotHeader header;
+    bool ok = file->size() >= sizeof(header);
+    if (ok) {
+        std::memcpy(&header, file->data(), sizeof(header));
+        uint64_t cells = (uint64_t)(header.columns > 0 ? header.columns : 0) * (uint64_t)(header.rows > 0 ? header.rows : 0);
+        ok = std::memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) == 0 &&
+            header.version == kSnapshotVersion &&
+            header.headerSize == sizeof(SnapshotHeader) &&
+            header.vertexCount >= 3 && header.columns > 0 && header.rows > 0 &&
+            header.cellWidth > 0 && header.cellHeight > 0 &&
+            header.verticesOffset == align8(sizeof(SnapshotHeader)) &&
+            header.cellStartOffset == align8(header.verticesOffset + (uint64_t)header.vertexCount * 2 * sizeof(float)) &&
+            header.cellEdgesOffset == align8(header.cellStartOffset + (cells + 1) * sizeof(uint32_t)) &&
+            header.fileSize == header.cellEdgesOffset + header.cellEdgeCount * sizeof(uint32_t) &&
+            header.fileSize == file->size();
+    }
+    if (ok) {
+        // Последний элемент таблицы начал — общее число индексов; сами индексы не проверяются (это O(n))
+        const uint32_t* starts = reinterpret_cast<const uint32_t*>(file->data() + header.cellStartOffset);
+        uint64_t cells = (uint64_t)header.columns * (uint64_t)header.rows;
+        ok = starts[0] == 0 && starts[cells] == header.cellEdgeCount;
+    }
+    if (!ok) {
+        err.type = ErrorType::invalidFileFormat;
+        err.errorMessage = "Файл не является снимком многоугольника или повреждён.";
+        return false;
+    }
+
+    count = (int)header.vertexCount;
+    box.minX = header.minX;
+    box.minY = header.minY;
+    box.maxX = header.maxX;
+    box.maxY = header.maxY;
+    cols = header.columns;
+    rowCount = header.rows;
+    cellWidth = header.cellWidth;
+    cellHeight = header.cellHeight;
+    storedFingerprint = header.fingerprint;
+    vertexData = reinterpret_cast<const float*>(file->data() + header.verticesOffset);
+    cellStart = reinterpret_cast<const uint32_t*>(file->data() + header.cellStartOffset);
+    cellEdges = reinterpret_cast<const uint32_t*>(file->data() + header.cellEdgesOffset);
+    mapping = std::move(file);
+    return true;
+}
+
+bool PolygonSnapshot::cellHasEdge(int cell, uint32_t edge) const {
+    return std::binary_search(cellEdges + cellStart[cell], cellEdges + cellStart[cell + 1], edge);
+}
+
+bool PolygonSnapshot::contains(const Point& p) const {
+    if (mapping == nullptr || !box.contains(p)) return false;
+
+    // Те же формулы, что в EdgeIndex::columnOf / rowOf
+    int row = std::min(std::max((int)std::floor((p.y - box.minY) / (double)cellHeight), 0), rowCount - 1);
+    int column = std::min(std::max((int)std::floor((p.x - box.minX) / (double)cellWidth), 0), cols - 1);
+
+    // Ребро, пересекающее луч вправо от p, лежит в строке точки не левее её столбца (с запасом
+    // в один столбец). В строке ребро занимает непрерывный отрезок столбцов, поэтому оно
+    // учитывается один раз — в первой просматриваемой ячейке этого отрезка.
+    bool inside = false;
+    int firstColumn = std::max(column - 1, 0);
+    for (int c = firstColumn; c < cols; ++c) {
+        int cell = row * cols + c;
+        for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+            uint32_t e = cellEdges[k];
+            if (c > firstColumn && cellHasEdge(cell - 1, e)) continue;  // Уже учтено левее
+            Point a = vertex((int)e);
+            Point b = vertex((int)((e + 1) % (uint32_t)count));
+            if (pointOnSegment(a, p, b)) return true;  // Граница принадлежит многоугольнику
+            if ((a.y > p.y) != (b.y > p.y)) {
+                // x пересечения правее p, если знак векторного произведения совпадает с направлением ребра по y
+                double cross = crossProduct(a, b, p);
+                if ((b.y > a.y) ? cross > 0 : cross < 0) inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+bool PolygonSnapshot::verify() const {
+    return mapping != nullptr && fingerprintOf(toPolygon().vertices) == storedFingerprint;
+}
+
+Polygon PolygonSnapshot::toPolygon() const {
+    std::vector<Point> vertices;
+    vertices.reserve(count);
+    for (int i = 0; i < count; ++i) vertices.push_back(vertex(i));
+    return Polygon(vertices);
+}
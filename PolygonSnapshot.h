@@ -0,0 +1,77 @@
+﻿#pragma once
+
+#include "Error.h"
+#include "Geometry.h"
+#include "MappedFile.h"
+#include "Point.h"
+#include "Polygon.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/// \brief Подготовленный многоугольник в двоичном файле, загружаемом отображением в память.
+///
+/// Файл содержит вершины, ограничивающий прямоугольник, таблицы сетки рёбер EdgeIndex (CSR)
+/// и отпечаток вершин (FNV-1a). Все ссылки внутри файла — смещения от его начала, поэтому файл
+/// не зависит от адреса загрузки. open() проверяет только заголовок и согласованность размеров —
+/// без разбора текста, валидации и построения индекса — и сразу готов отвечать на запросы.
+/// Файл записывается в порядке байтов машины (little-endian на поддерживаемых платформах).
+class PolygonSnapshot {
+public:
+    PolygonSnapshot() = default;
+
+    PolygonSnapshot(PolygonSnapshot&&) = default;
+    PolygonSnapshot& operator=(PolygonSnapshot&&) = default;
+
+    /// \brief Строит индекс рёбер и записывает снимок многоугольника.
+    /// \param polygon      Многоугольник, уже прошедший Polygon::isValid.
+    /// \param cellsPerAxis Размер сетки EdgeIndex; 0 — автоматически.
+    /// \param[out] err     Объект ошибки (outputFileCreateFail).
+    static bool write(const Polygon& polygon, const std::string& fileName, Error& err, int cellsPerAxis = 0);
+
+    /// \brief Открывает снимок, отображая файл в память.
+    /// \param[out] err Объект ошибки (inputFileNotExist, invalidFileFormat).
+    bool open(const std::string& fileName, Error& err);
+
+    /// \brief Проверяет принадлежность точки (граница принадлежит многоугольнику).
+    /// \details Рассматриваются только рёбра из строки сетки точки правее неё: луч вправо
+    ///          пересекает лишь их. Векторные произведения вычисляются без усечения (Geometry.h).
+    bool contains(const Point& p) const;
+
+    /// \brief Сверяет отпечаток вершин с записанным (O(n), для проверки целостности файла).
+    bool verify() const;
+
+    /// Количество вершин
+    int vertexCount() const { return count; }
+
+    /// Вершина i
+    Point vertex(int i) const { return Point(vertexData[2 * i], vertexData[2 * i + 1]); }
+
+    /// Ограничивающий прямоугольник
+    const BoundingBox& bounds() const { return box; }
+
+    /// Отпечаток вершин, записанный в файле
+    uint64_t fingerprint() const { return storedFingerprint; }
+
+    /// Копия многоугольника (вершины из снимка)
+    Polygon toPolygon() const;
+
+    /// \brief Отпечаток FNV-1a 64 по числу вершин и их координатам.
+    static uint64_t fingerprintOf(const std::vector<Point>& vertices);
+
+private:
+    std::unique_ptr<MappedFile> mapping;     // Отображение файла
+    int count = 0;                           // Число вершин
+    const float* vertexData = nullptr;       // Пары координат вершин
+    BoundingBox box;                         // Прямоугольник сетки
+    int cols = 0;                            // Число столбцов сетки
+    int rowCount = 0;                        // Число строк сетки
+    float cellWidth = 1.0f;                  // Ширина ячейки
+    float cellHeight = 1.0f;                 // Высота ячейки
+    const uint32_t* cellStart = nullptr;     // CSR: начало списка рёбер ячейки
+    const uint32_t* cellEdges = nullptr;     // CSR: индексы рёбер (по возрастанию в каждой ячейке)
+    uint64_t storedFingerprint = 0;          // Отпечаток из заголовка
+
+    /// Есть ли ребро edge в ячейке cell (двоичный поиск по отсортированному списку)
+    bool cellHasEdge(int cell, uint32_t edge) const;
+};
@@ -0,0 +1,251 @@
+﻿#include "RasterMask.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+/// Заголовок файла маски (все смещения — от начала файла, кратны 8)
+struct RasterMaskHeader {
+    char magic[8];            // "PPCMASK"
+    uint32_t version;         // Версия формата
+    uint32_t headerSize;      // sizeof(RasterMaskHeader)
+    int32_t columns;          // Число столбцов
+    int32_t rows;             // Число строк
+    float minX, minY, maxX, maxY;  // Прямоугольник сетки
+    uint32_t vertexCount;     // Число вершин многоугольника
+    uint32_t reserved;        // Выравнивание
+    uint64_t wordsPerRow;     // Слов на строку битовой карты
+    uint64_t insideOffset;    // Смещение битовой карты внутренних ячеек
+    uint64_t boundaryOffset;  // Смещение битовой карты граничных ячеек
+    uint64_t verticesOffset;  // Смещение массива вершин (пары float)
+    uint64_t fileSize;        // Полный размер файла
+};
+
+const char kMaskMagic[8] = { 'P', 'P', 'C', 'M', 'A', 'S', 'K', '\0' };
+const uint32_t kMaskVersion = 1;
+
+/// Округление вверх до кратного 8
+uint64_t align8(uint64_t value) {
+    return (value + 7) & ~(uint64_t)7;
+}
+
+}
+
+void RasterMask::setGrid(const BoundingBox& bounds, int columns, int rows) {
+    box = bounds;
+    cols = std::max(1, columns);
+    rowCount = std::max(1, rows);
+    float width = box.maxX - box.minX;
+    float height = box.maxY - box.minY;
+    cellWidth = width > 0 ? width / cols : 1.0f;
+    cellHeight = height > 0 ? height / rowCount : 1.0f;
+    wordsPerRow = ((size_t)cols + 63) / 64;
+}
+
+RasterMask::RasterMask(const Polygon& polygon, int columns, int rows)
+    : polygon(polygon)
+{
+    setGrid(polygon.boundingBox(), columns, rows);
+    size_t words = wordsPerRow * rowCount;
+    ownedBits.assign(words * 2, 0);
+    uint64_t* inside = ownedBits.data();
+    uint64_t* boundary = ownedBits.data() + words;
+    auto setBit = [&](uint64_t* bits, int r, int c) {
+        bits[(size_t)r * wordsPerRow + (size_t)c / 64] |= (uint64_t)1 << (c % 64);
+    };
+
+    const std::vector<Point>& v = polygon.vertices;
+    int n = (int)v.size();
+    if (n == 0) return;
+
+    // 1) Граничные ячейки: каждое ребро помечает все ячейки, которых касается.
+    //    Полосы строк и x-диапазоны расширяются на eps, чтобы касание по границе ячейки не терялось.
+    const double epsX = cellWidth * 1e-4;
+    const double epsY = cellHeight * 1e-4;
+    for (int i = 0; i < n; ++i) {
+        double ax = v[i].x, ay = v[i].y;
+        double bx = v[(i + 1) % n].x, by = v[(i + 1) % n].y;
+        if (ay > by) {
+            std::swap(ax, bx);
+            std::swap(ay, by);
+        }
+        int rowFrom = std::max(0, (int)std::floor((ay - epsY - box.minY) / cellHeight));
+        int rowTo = std::min(rowCount - 1, (int)std::floor((by + epsY - box.minY) / cellHeight));
+        for (int r = rowFrom; r <= rowTo; ++r) {
+            double y0 = std::max(ay, box.minY + (double)r * cellHeight - epsY);
+            double y1 = std::min(by, box.minY + (double)(r + 1) * cellHeight + epsY);
+            double x0 = ax, x1 = bx;
+            if (by > ay) {
+                x0 = ax + (bx - ax) * (y0 - ay) / (by - ay);
+                x1 = ax + (bx - ax) * (y1 - ay) / (by - ay);
+            }
+            if (x0 > x1) std::swap(x0, x1);
+            int colFrom = std::max(0, (int)std::floor((x0 - epsX - box.minX) / cellWidth));
+            int colTo = std::min(cols - 1, (int)std::floor((x1 + epsX - box.minX) / cellWidth));
+            for (int c = colFrom; c <= colTo; ++c) {
+                setBit(boundary, r, c);
+            }
+        }
+    }
+
+    // 2) Внутренние ячейки: развёртка по центрам строк с таблицей активных рёбер.
+    //    Ребро активно на высоте y, если (a.y > y) != (b.y > y) — то же правило, что в contains.
+    std::vector<int> edges;  // Негоризонтальные рёбра, упорядоченные по нижнему концу
+    for (int i = 0; i < n; ++i) {
+        if (v[i].y != v[(i + 1) % n].y) edges.push_back(i);
+    }
+    auto lowY = [&](int e) { return std::min(v[e].y, v[(e + 1) % n].y); };
+    auto highY = [&](int e) { return std::max(v[e].y, v[(e + 1) % n].y); };
+    std::sort(edges.begin(), edges.end(), [&](int l, int r) { return lowY(l) < lowY(r); });
+
+    std::vector<int> active;
+    std::vector<double> xs;
+    size_t next = 0;  // Первое ещё не добавленное ребро
+    for (int r = 0; r < rowCount; ++r) {
+        double yc = box.minY + (r + 0.5) * cellHeight;
+        while (next < edges.size() && lowY(edges[next]) <= yc) {
+            active.push_back(edges[next++]);
+        }
+        // Рёбра, закончившиеся ниже центра строки, больше не понадобятся
+        active.erase(std::remove_if(active.begin(), active.end(), [&](int e) { return highY(e) <= yc; }), active.end());
+
+        xs.clear();
+        for (int e : active) {
+            const Point& a = v[e];
+            const Point& b = v[(e + 1) % n];
+            xs.push_back(a.x + ((double)b.x - a.x) * (yc - a.y) / ((double)b.y - a.y));
+        }
+        std::sort(xs.begin(), xs.end());
+        for (size_t k = 0; k + 1 < xs.size(); k += 2) {
+            // Ячейки, центры которых лежат строго между парой пересечений
+            int colFrom = std::max(0, (int)std::ceil((xs[k] - box.minX) / cellWidth - 0.5));
+            int colTo = std::min(cols - 1, (int)std::floor((xs[k + 1] - box.minX) / cellWidth - 0.5));
+            for (int c = colFrom; c <= colTo; ++c) {
+                if (!testBit(boundary, r, c)) setBit(inside, r, c);
+            }
+        }
+    }
+
+    insideBits = inside;
+    boundaryBits = boundary;
+}
+
+MaskCell RasterMask::lookup(const Point& p) const {
+    if (insideBits == nullptr || !box.contains(p)) return MaskCell::outside;
+    int c = std::min((int)((p.x - box.minX) / cellWidth), cols - 1);
+    int r = std::min((int)((p.y - box.minY) / cellHeight), rowCount - 1);
+    if (testBit(boundaryBits, r, c)) return MaskCell::boundary;
+    return testBit(insideBits, r, c) ? MaskCell::inside : MaskCell::outside;
+}
+
+bool RasterMask::contains(const Point& p) const {
+    switch (lookup(p)) {
+    case MaskCell::inside: return true;
+    case MaskCell::outside: return false;
+    default: return polygon.contains(p);  // Граничная ячейка — точная проверка
+    }
+}
+
+size_t RasterMask::boundaryCellCount() const {
+    size_t count = 0;
+    for (size_t w = 0; boundaryBits != nullptr && w < wordsPerRow * rowCount; ++w) {
+        for (uint64_t bits = boundaryBits[w]; bits != 0; bits &= bits - 1) ++count;
+    }
+    return count;
+}
+
+bool RasterMask::save(const std::string& fileName, Error& err) const {
+    err.errorOutputFileWay = fileName;
+    size_t words = wordsPerRow * rowCount;
+
+    RasterMaskHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMaskMagic, sizeof(header.magic));
+    header.version = kMaskVersion;
+    header.headerSize = sizeof(RasterMaskHeader);
+    header.columns = cols;
+    header.rows = rowCount;
+    header.minX = box.minX;
+    header.minY = box.minY;
+    header.maxX = box.maxX;
+    header.maxY = box.maxY;
+    header.vertexCount = (uint32_t)polygon.vertices.size();
+    header.wordsPerRow = wordsPerRow;
+    header.insideOffset = align8(sizeof(RasterMaskHeader));
+    header.boundaryOffset = header.insideOffset + words * sizeof(uint64_t);
+    header.verticesOffset = header.boundaryOffset + words * sizeof(uint64_t);
+    header.fileSize = header.verticesOffset + (uint64_t)header.vertexCount * 2 * sizeof(float);
+
+    std::ofstream fout(fileName, std::ios::binary);
+    if (!fout.is_open()) {
+        err.type = ErrorType::outputFileCreateFail;
+        err.errorMessage = "Не удалось создать файл растровой маски.";
+        return false;
+    }
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (uint64_t pad = sizeof(header); pad < header.insideOffset; ++pad) fout.put('\0');
+    if (words > 0) {
+        fout.write(reinterpret_cast<const char*>(insideBits), words * sizeof(uint64_t));
+        fout.write(reinterpret_cast<const char*>(boundaryBits), words * sizeof(uint64_t));
+    }
+    for (const Point& p : polygon.vertices) {
+        fout.write(reinterpret_cast<const char*>(&p.x), sizeof(float));
+        fout.write(reinterpret_cast<const char*>(&p.y), sizeof(float));
+    }
+    if (!fout) {
+        err.type = ErrorType::outputFileCreateFail;
+        err.errorMessage = "Ошибка записи файла растровой маски.";
+        return false;
+    }
+    return true;
+}
+
+bool RasterMask::load(const std::string& fileName, Error& err) {
+    std::unique_ptr<MappedFile> file(new MappedFile());
+    if (!file->open(fileName, err)) return false;
+
+    // Проверка заголовка и согласованности размеров до любого обращения к данным
+    RasterMaskHeader header;
+    bool ok = file->size() >= sizeof(header);
+    if (ok) {
+        std::memcpy(&header, file->data(), sizeof(header));
+        uint64_t words = header.wordsPerRow * (uint64_t)(header.rows > 0 ? header.rows : 0);
+        ok = std::memcmp(header.magic, kMaskMagic, sizeof(kMaskMagic)) == 0 &&
+            header.version == kMaskVersion &&
+            header.headerSize == sizeof(RasterMaskHeader) &&
+            header.columns > 0 && header.rows > 0 &&
+            header.wordsPerRow == ((uint64_t)header.columns + 63) / 64 &&
+            header.insideOffset % 8 == 0 && header.insideOffset >= sizeof(header) &&
+            header.boundaryOffset == header.insideOffset + words * sizeof(uint64_t) &&
+            header.verticesOffset == header.boundaryOffset + words * sizeof(uint64_t) &&
+            header.fileSize == header.verticesOffset + (uint64_t)header.vertexCount * 2 * sizeof(float) &&
+            header.fileSize == file->size();
+    }
+    if (!ok) {
+        err.type = ErrorType::invalidFileFormat;
+        err.errorMessage = "Файл не является растровой маской многоугольника или повреждён.";
+        return false;
+    }
+
+    BoundingBox bounds;
+    bounds.minX = header.minX;
+    bounds.minY = header.minY;
+    bounds.maxX = header.maxX;
+    bounds.maxY = header.maxY;
+    setGrid(bounds, header.columns, header.rows);
+
+    // Вершины копируются (их мало), битовые карты остаются в отображении
+    const unsigned char* raw = file->data() + header.verticesOffset;
+    polygon.vertices.resize(header.vertexCount);
+    for (uint32_t i = 0; i < header.vertexCount; ++i) {
+        std::memcpy(&polygon.vertices[i].x, raw + (size_t)i * 8, sizeof(float));
+        std::memcpy(&polygon.vertices[i].y, raw + (size_t)i * 8 + 4, sizeof(float));
+    }
+    ownedBits.clear();
+    insideBits = reinterpret_cast<const uint64_t*>(file->data() + header.insideOffset);
+    boundaryBits = reinterpret_cast<const uint64_t*>(file->data() + header.boundaryOffset);
+    mapping = std::move(file);
+    return true;
+}
@@ -0,0 +1,90 @@
+﻿#pragma once
+
+#include "Error.h"
+#include "Geometry.h"
+#include "MappedFile.h"
+#include "Point.h"
+#include "Polygon.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Состояние ячейки растровой маски
+enum class MaskCell {
+    outside,   // Ячейка целиком вне многоугольника
+    inside,    // Ячейка целиком внутри многоугольника
+    boundary   // Через ячейку проходит граница — нужна точная проверка
+};
+
+/// \brief Растровая маска многоугольника для приближённых проверок за O(1).
+///
+/// Ограничивающий прямоугольник многоугольника делится на columns x rows ячеек. Ячейки, через
+/// которые проходит граница, помечаются в отдельной битовой карте и проверяются точно через
+/// Polygon::contains; для остальных ответ — один бит. Внутренние ячейки находятся построчной
+/// развёрткой с таблицей активных рёбер (active edge table) по центрам ячеек.
+///
+/// Маску можно сохранить в двоичный файл и загрузить через отображение в память (MappedFile):
+/// битовые карты при этом не копируются.
+class RasterMask {
+public:
+    /// Пустая маска (все точки вне)
+    RasterMask() = default;
+
+    /// \brief Строит маску для валидного многоугольника.
+    /// \param polygon Многоугольник (копируется для точных проверок граничных ячеек).
+    /// \param columns Число столбцов сетки (не меньше 1).
+    /// \param rows    Число строк сетки (не меньше 1).
+    RasterMask(const Polygon& polygon, int columns, int rows);
+
+    RasterMask(RasterMask&&) = default;
+    RasterMask& operator=(RasterMask&&) = default;
+
+    /// \brief Состояние ячейки, в которую попадает точка p (вне прямоугольника — outside).
+    MaskCell lookup(const Point& p) const;
+
+    /// \brief Проверяет принадлежность точки: один бит для внутренних и внешних ячеек,
+    ///        Polygon::contains — для граничных.
+    bool contains(const Point& p) const;
+
+    /// \brief Сохраняет маску (битовые карты и вершины) в двоичный файл.
+    /// \param[out] err Объект ошибки (outputFileCreateFail при ошибке записи).
+    bool save(const std::string& fileName, Error& err) const;
+
+    /// \brief Загружает маску, отображая файл в память.
+    /// \param[out] err Объект ошибки (inputFileNotExist, invalidFileFormat).
+    bool load(const std::string& fileName, Error& err);
+
+    /// Число столбцов сетки
+    int columns() const { return cols; }
+
+    /// Число строк сетки
+    int rows() const { return rowCount; }
+
+    /// Прямоугольник, покрываемый маской
+    const BoundingBox& bounds() const { return box; }
+
+    /// Количество граничных ячеек (требующих точной проверки)
+    size_t boundaryCellCount() const;
+
+private:
+    Polygon polygon;                      // Многоугольник для точной проверки граничных ячеек
+    BoundingBox box;                      // Прямоугольник, покрываемый сеткой
+    int cols = 0;                         // Число столбцов
+    int rowCount = 0;                     // Число строк
+    float cellWidth = 1.0f;               // Ширина ячейки
+    float cellHeight = 1.0f;              // Высота ячейки
+    size_t wordsPerRow = 0;               // Число 64-битных слов на строку битовой карты
+    std::vector<uint64_t> ownedBits;      // Битовые карты построенной маски: сначала inside, затем boundary
+    std::unique_ptr<MappedFile> mapping;  // Отображение файла загруженной маски
+    const uint64_t* insideBits = nullptr;    // Биты внутренних ячеек (в ownedBits или в отображении)
+    const uint64_t* boundaryBits = nullptr;  // Биты граничных ячеек (в ownedBits или в отображении)
+
+    /// Настройка геометрии сетки по прямоугольнику и размерам
+    void setGrid(const BoundingBox& bounds, int columns, int rows);
+
+    /// Значение бита ячейки (r, c) в битовой карте bits
+    bool testBit(const uint64_t* bits, int r, int c) const {
+        return (bits[(size_t)r * wordsPerRow + (size_t)c / 64] >> (c % 64)) & 1u;
+    }
+};
@@ -0,0 +1,217 @@
+﻿#include "ResultWriter.h"
+#include "IOManager.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const size_t kBlockSize = 4096;  // Выравнивание буфера и размер блока для O_DIRECT
+
+// Перевод строки текстовых форматов — как у прежней записи через std::ofstream в текстовом режиме
+#ifdef _WIN32
+const char kNewLine[] = "\r\n";
+#else
+const char kNewLine[] = "\n";
+#endif
+const size_t kNewLineLength = sizeof(kNewLine) - 1;
+
+/// Запись всего диапазона с повтором при частичной записи
+bool writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+#ifdef _WIN32
+        int chunk = _write(fd, data, (unsigned)(length > (1u << 30) ? (1u << 30) : length));
+#else
+        ssize_t chunk = ::write(fd, data, length);
+        if (chunk < 0 && errno == EINTR) continue;
+#endif
+        if (chunk <= 0) return false;
+        data += chunk;
+        length -= (size_t)chunk;
+    }
+    return true;
+}
+
+}
+
+ResultWriter::ResultWriter(const ResultWriterOptions& options)
+    : options(options)
+{
+}
+
+ResultWriter::~ResultWriter() {
+    Error ignored;
+    close(ignored);
+}
+
+bool ResultWriter::parseFormat(const std::string& name, ResultFormat& format) {
+    if (name == "text") format = ResultFormat::text;
+    else if (name == "byte") format = ResultFormat::byte;
+    else if (name == "bitset") format = ResultFormat::bitset;
+    else if (name == "csv") format = ResultFormat::csv;
+    else return false;
+    return true;
+}
+
+bool ResultWriter::open(const std::string& fileName, Error& err) {
+    Error previous;
+    close(previous);
+    path = fileName;
+    err.errorOutputFileWay = fileName;
+
+#ifdef _WIN32
+    fd = _open(fileName.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    direct = false;
+#ifdef O_DIRECT
+    if (options.directIo) {
+        fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+        direct = fd >= 0;
+    }
+#endif
+    if (fd < 0) fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    if (fd < 0) {
+        err.type = ErrorType::outputFileCreateFail;
+        err.errorMessage = "Неверно указан файл для выходных данных. Возможно, указанного расположения не существует или нет прав на запись.";
+        return false;
+    }
+
+    // Буфер кратен блоку и выровнен по нему (требование O_DIRECT)
+    capacity = ((options.bufferBytes + kBlockSize - 1) / kBlockSize) * kBlockSize;
+    if (capacity == 0) capacity = kBlockSize;
+    storage.resize(capacity + kBlockSize);
+    size_t misalignment = (size_t)((uintptr_t)storage.data() % kBlockSize);
+    buffer = storage.data() + (misalignment == 0 ? 0 : kBlockSize - misalignment);
+    used = 0;
+    written = 0;
+    failed = false;
+    pendingBits = 0;
+    pendingBitCount = 0;
+
+    if (options.format == ResultFormat::csv) {
+        append("id,inside", 9);
+        append(kNewLine, kNewLineLength);
+    }
+    return true;
+}
+
+void ResultWriter::append(const char* data, size_t length) {
+    while (length > 0) {
+        reserve(1);
+        size_t part = std::min(length, capacity - used);
+        std::memcpy(buffer + used, data, part);
+        used += part;
+        data += part;
+        length -= part;
+    }
+}
+
+void ResultWriter::write(bool result) {
+    switch (options.format) {
+    case ResultFormat::text: {
+        const char* text = IOManager::resultText(result);
+        size_t length = std::strlen(text);
+        reserve(length + kNewLineLength);
+        std::memcpy(buffer + used, text, length);
+        used += length;
+        std::memcpy(buffer + used, kNewLine, kNewLineLength);
+        used += kNewLineLength;
+        break;
+    }
+    case ResultFormat::byte:
+        reserve(1);
+        buffer[used++] = result ? 1 : 0;
+        break;
+    case ResultFormat::bitset:
+        pendingBits |= (uint8_t)((result ? 1 : 0) << pendingBitCount);
+        if (++pendingBitCount == 8) {
+            reserve(1);
+            buffer[used++] = (char)pendingBits;
+            pendingBits = 0;
+            pendingBitCount = 0;
+        }
+        break;
+    case ResultFormat::csv: {
+        reserve(32);  // Номер (до 20 цифр), запятая, результат и перевод строки
+        std::to_chars_result converted = std::to_chars(buffer + used, buffer + used + 24, (unsigned long long)written);
+        used = (size_t)(converted.ptr - buffer);
+        buffer[used++] = ',';
+        buffer[used++] = result ? '1' : '0';
+        std::memcpy(buffer + used, kNewLine, kNewLineLength);
+        used += kNewLineLength;
+        break;
+    }
+    }
+    ++written;
+}
+
+void ResultWriter::write(const uint8_t* results, size_t count) {
+    // Однобайтовый формат копируется блоками без разбора по точкам
+    if (options.format == ResultFormat::byte) {
+        for (size_t done = 0; done < count;) {
+            reserve(1);
+            size_t part = std::min(count - done, capacity - used);
+            for (size_t i = 0; i < part; ++i) buffer[used + i] = results[done + i] != 0 ? 1 : 0;
+            used += part;
+            done += part;
+        }
+        written += count;
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) write(results[i] != 0);
+}
+
+void ResultWriter::flush(bool final) {
+    if (fd < 0 || used == 0) return;
+    size_t length = used;
+    if (direct && !final) {
+        length = (used / kBlockSize) * kBlockSize;  // С O_DIRECT пишутся только целые блоки
+        if (length == 0) return;
+    }
+#if !defined(_WIN32) && defined(O_DIRECT)
+    if (direct && final && length % kBlockSize != 0) {
+        // Хвост не кратен блоку — дописываем его обычной записью
+        int flags = fcntl(fd, F_GETFL);
+        if (flags >= 0) fcntl(fd, F_SETFL, flags & ~O_DIRECT);
+        direct = false;
+    }
+#endif
+    if (!writeAll(fd, buffer, length)) failed = true;
+    std::memmove(buffer, buffer + length, used - length);
+    used -= length;
+}
+
+bool ResultWriter::close(Error& err) {
+    if (fd < 0) return true;
+    if (pendingBitCount > 0) {  // Неполный последний байт битовой строки
+        reserve(1);
+        buffer[used++] = (char)pendingBits;
+        pendingBits = 0;
+        pendingBitCount = 0;
+    }
+    flush(true);
+#ifdef _WIN32
+    if (_close(fd) != 0) failed = true;
+#else
+    if (::close(fd) != 0) failed = true;
+#endif
+    fd = -1;
+    if (failed) {
+        err.type = ErrorType::outputFileCreateFail;
+        err.errorOutputFileWay = path;
+        err.errorMessage = "Ошибка записи результатов в выходной файл.";
+        return false;
+    }
+    return true;
+}
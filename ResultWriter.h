@@ -0,0 +1,83 @@
+﻿#pragma once
+
+#include "Error.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Формат записи результатов проверки
+enum class ResultFormat {
+    text,    // Строка "принадлежит" / "не принадлежит" на точку (прежний формат)
+    byte,    // Один байт 0/1 на точку
+    bitset,  // Упакованные биты: точка i — бит (i % 8) байта i / 8 (младший бит первым)
+    csv      // Строки "id,inside" — номер точки с 0 и результат 0/1, с заголовком
+};
+
+/// \brief Настройки записи результатов.
+struct ResultWriterOptions {
+    ResultFormat format = ResultFormat::text;  // Формат записи
+    size_t bufferBytes = 1 << 20;              // Размер буфера; сбрасывается на диск целиком
+    bool directIo = false;                     // Запись в обход кэша ОС (O_DIRECT), если поддерживается
+};
+
+/// \brief Буферизованная запись результатов проверки в файл в одном из форматов ResultFormat.
+///
+/// Результаты накапливаются в большом повторно используемом буфере и сбрасываются на диск
+/// крупными блоками прямыми вызовами write(). С directIo буфер выравнивается по 4 КиБ, файл
+/// открывается с O_DIRECT (Linux) и сбрасываются только целые блоки; хвост дописывается при
+/// закрытии обычной записью. Если O_DIRECT не поддерживается файловой системой — обычная запись.
+class ResultWriter {
+public:
+    explicit ResultWriter(const ResultWriterOptions& options = ResultWriterOptions());
+    ~ResultWriter();
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    /// \brief Создаёт (перезаписывает) выходной файл.
+    /// \param[out] err Объект ошибки (outputFileCreateFail).
+    bool open(const std::string& fileName, Error& err);
+
+    /// \brief Добавляет результат очередной точки.
+    void write(bool result);
+
+    /// \brief Добавляет результаты count точек (results[i] != 0 — принадлежит).
+    void write(const uint8_t* results, size_t count);
+
+    /// \brief Дописывает буфер и закрывает файл.
+    /// \param[out] err Объект ошибки (outputFileCreateFail, если какая-либо запись не удалась).
+    bool close(Error& err);
+
+    /// Количество записанных результатов
+    size_t count() const { return written; }
+
+    /// \brief Разбирает название формата: "text", "byte", "bitset", "csv".
+    /// \return true, если название известно.
+    static bool parseFormat(const std::string& name, ResultFormat& format);
+
+private:
+    ResultWriterOptions options;  // Настройки
+    std::string path;             // Путь к файлу
+    int fd = -1;                  // Дескриптор файла
+    bool direct = false;          // Файл открыт с O_DIRECT
+    bool failed = false;          // Была ошибка записи
+    std::vector<char> storage;    // Память буфера (с запасом на выравнивание)
+    char* buffer = nullptr;       // Начало буфера (выровнено по 4 КиБ)
+    size_t capacity = 0;          // Ёмкость буфера
+    size_t used = 0;              // Заполнено байт
+    size_t written = 0;           // Записано результатов
+    uint8_t pendingBits = 0;      // Неполный байт формата bitset
+    int pendingBitCount = 0;      // Число битов в pendingBits
+
+    /// Сбрасывает буфер; при directIo и final == false — только целые блоки по 4 КиБ
+    void flush(bool final);
+
+    /// Гарантирует bytes свободных байт в буфере
+    void reserve(size_t bytes) {
+        if (used + bytes > capacity) flush(false);
+    }
+
+    /// Добавляет байты в буфер
+    void append(const char* data, size_t length);
+};
@@ -0,0 +1,120 @@
+﻿#include "SpatialJoin.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+SpatialJoin::SpatialJoin(const std::vector<Polygon>& polygons, int cellsPerAxis)
+    : polygons(polygons)
+{
+    int count = (int)polygons.size();
+    if (count == 0) return;
+
+    boxes.reserve(count);
+    for (const Polygon& polygon : polygons) {
+        boxes.push_back(polygon.boundingBox());
+    }
+    layerBox = boxes[0];
+    for (const BoundingBox& box : boxes) {
+        layerBox.expand(Point(box.minX, box.minY));
+        layerBox.expand(Point(box.maxX, box.maxY));
+    }
+
+    // По умолчанию около одного многоугольника на ячейку
+    if (cellsPerAxis <= 0) {
+        cellsPerAxis = (int)std::ceil(std::sqrt((double)count));
+    }
+    cols = rows = std::max(1, cellsPerAxis);
+    float width = layerBox.maxX - layerBox.minX;
+    float height = layerBox.maxY - layerBox.minY;
+    cellWidth = width > 0 ? width / cols : 1.0f;
+    cellHeight = height > 0 ? height / rows : 1.0f;
+
+    // Многоугольник попадает во все ячейки, пересекающие его прямоугольник (два прохода, CSR)
+    auto forEachCell = [&](const BoundingBox& box, auto visit) {
+        int c0 = cellOf(Point(box.minX, box.minY)) % cols;
+        int r0 = cellOf(Point(box.minX, box.minY)) / cols;
+        int c1 = cellOf(Point(box.maxX, box.maxY)) % cols;
+        int r1 = cellOf(Point(box.maxX, box.maxY)) / cols;
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) visit(r * cols + c);
+        }
+    };
+    std::vector<uint32_t> counts((size_t)cols * rows + 1, 0);
+    for (int i = 0; i < count; ++i) {
+        forEachCell(boxes[i], [&](int cell) { ++counts[cell + 1]; });
+    }
+    for (size_t c = 1; c < counts.size(); ++c) counts[c] += counts[c - 1];
+    cellStart = counts;
+    cellPolygons.resize(cellStart.back());
+    for (int i = 0; i < count; ++i) {
+        forEachCell(boxes[i], [&](int cell) { cellPolygons[counts[cell]++] = (uint32_t)i; });
+    }
+}
+
+int SpatialJoin::cellOf(const Point& p) const {
+    int c = std::min(std::max((int)std::floor((p.x - layerBox.minX) / cellWidth), 0), cols - 1);
+    int r = std::min(std::max((int)std::floor((p.y - layerBox.minY) / cellHeight), 0), rows - 1);
+    return r * cols + c;
+}
+
+uint32_t SpatialJoin::mortonKey(const Point& p, const BoundingBox& box) {
+    // Квантование в 16 бит на ось
+    auto quantize = [](float v, float lo, float hi) -> uint32_t {
+        if (!(hi > lo)) return 0;
+        double t = ((double)v - lo) / ((double)hi - lo);
+        t = std::min(std::max(t, 0.0), 1.0);
+        return (uint32_t)(t * 65535.0 + 0.5);
+    };
+    // Раздвигает 16 бит так, чтобы между ними были нули: abcd → 0a0b0c0d
+    auto spread = [](uint32_t v) {
+        v = (v | (v << 8)) & 0x00FF00FFu;
+        v = (v | (v << 4)) & 0x0F0F0F0Fu;
+        v = (v | (v << 2)) & 0x33333333u;
+        v = (v | (v << 1)) & 0x55555555u;
+        return v;
+    };
+    return spread(quantize(p.x, box.minX, box.maxX)) | (spread(quantize(p.y, box.minY, box.maxY)) << 1);
+}
+
+void SpatialJoin::join(const std::vector<Point>& points, JoinResult& result, JoinStats& stats) const {
+    auto started = std::chrono::steady_clock::now();
+    stats = JoinStats();
+    stats.points = points.size();
+
+    // 1) Сортировка по Z-порядку: ключ в старших 32 битах, исходный номер точки — в младших
+    std::vector<uint64_t> order(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        order[i] = ((uint64_t)mortonKey(points[i], layerBox) << 32) | (uint64_t)i;
+    }
+    std::sort(order.begin(), order.end());
+
+    // 2) Проход по отсортированным точкам: кандидаты из ячейки, отсев по прямоугольнику, contains
+    std::vector<std::pair<uint32_t, int>> pairs;  // (исходный номер точки, номер многоугольника)
+    for (uint64_t entry : order) {
+        uint32_t index = (uint32_t)(entry & 0xFFFFFFFFu);
+        const Point& p = points[index];
+        if (cellStart.empty() || !layerBox.contains(p)) continue;
+        int cell = cellOf(p);
+        for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+            uint32_t id = cellPolygons[k];
+            if (!boxes[id].contains(p)) continue;
+            ++stats.containsCalls;
+            if (polygons[id].contains(p)) pairs.emplace_back(index, (int)id);
+        }
+    }
+    stats.matches = pairs.size();
+
+    // 3) Раскладка в исходный порядок сортировкой подсчётом по номеру точки.
+    //    Внутри точки номера многоугольников уже возрастают: точка проверяет одну ячейку,
+    //    а списки ячеек упорядочены по номеру многоугольника.
+    result.offsets.assign(points.size() + 1, 0);
+    for (const auto& pr : pairs) ++result.offsets[pr.first + 1];
+    for (size_t i = 1; i < result.offsets.size(); ++i) result.offsets[i] += result.offsets[i - 1];
+    result.polygonIds.resize(pairs.size());
+    for (const auto& pr : pairs) result.polygonIds[result.offsets[pr.first]++] = pr.second;
+    // offsets[i] сдвинулись на начало следующей точки — возвращаем их на место
+    for (size_t i = points.size(); i > 0; --i) result.offsets[i] = result.offsets[i - 1];
+    result.offsets[0] = 0;
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+}
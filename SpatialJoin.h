@@ -0,0 +1,67 @@
+﻿#pragma once
+
+#include "Geometry.h"
+#include "Point.h"
+#include "Polygon.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \brief Результат пространственного соединения в исходном порядке точек (формат CSR).
+///
+/// Номера многоугольников, содержащих точку i, лежат в polygonIds[offsets[i] .. offsets[i + 1]).
+struct JoinResult {
+    std::vector<size_t> offsets;  // Размер: число точек + 1
+    std::vector<int> polygonIds;  // Номера многоугольников по возрастанию для каждой точки
+};
+
+/// \brief Статистика выполнения соединения.
+struct JoinStats {
+    size_t points = 0;          // Количество обработанных точек
+    size_t containsCalls = 0;   // Количество вызовов Polygon::contains (после отсева по прямоугольникам)
+    size_t matches = 0;         // Количество пар (точка, многоугольник), где точка принадлежит многоугольнику
+    double seconds = 0.0;       // Время выполнения join()
+
+    /// Пропускная способность, точек в секунду
+    double pointsPerSecond() const { return seconds > 0 ? points / seconds : 0.0; }
+};
+
+/// \brief Пространственное соединение множества точек с набором многоугольников.
+///
+/// Многоугольники раскладываются по равномерной сетке ограничивающих прямоугольников.
+/// Точки запроса сортируются по ключу Мортона (Z-порядок), поэтому соседние по порядку
+/// точки попадают в одни и те же ячейки и проверяются против одних и тех же рёбер, пока те
+/// ещё в кэше. Результаты затем раскладываются обратно в исходный порядок точек.
+class SpatialJoin {
+public:
+    /// \brief Строит индекс прямоугольников для набора валидных многоугольников.
+    /// \param polygons     Многоугольники (копируются).
+    /// \param cellsPerAxis Число ячеек сетки по каждой оси; 0 — подобрать автоматически.
+    explicit SpatialJoin(const std::vector<Polygon>& polygons, int cellsPerAxis = 0);
+
+    /// \brief Для каждой точки находит все содержащие её многоугольники (граница считается принадлежащей).
+    /// \param[in]  points Точки запроса (не более 2^32 - 1).
+    /// \param[out] result Результат в исходном порядке точек.
+    /// \param[out] stats  Статистика и пропускная способность.
+    void join(const std::vector<Point>& points, JoinResult& result, JoinStats& stats) const;
+
+    /// Количество многоугольников
+    int polygonCount() const { return (int)polygons.size(); }
+
+    /// \brief Ключ Мортона точки: 16 бит на координату внутри прямоугольника box, биты чередуются.
+    static uint32_t mortonKey(const Point& p, const BoundingBox& box);
+
+private:
+    std::vector<Polygon> polygons;      // Многоугольники слоя
+    std::vector<BoundingBox> boxes;     // Их ограничивающие прямоугольники
+    BoundingBox layerBox;               // Прямоугольник всего слоя
+    int cols = 0;                       // Число столбцов сетки
+    int rows = 0;                       // Число строк сетки
+    float cellWidth = 1.0f;             // Ширина ячейки
+    float cellHeight = 1.0f;            // Высота ячейки
+    std::vector<uint32_t> cellStart;    // CSR: начало списка многоугольников ячейки
+    std::vector<uint32_t> cellPolygons; // CSR: номера многоугольников
+
+    /// Номер ячейки сетки для точки внутри layerBox
+    int cellOf(const Point& p) const;
+};
@@ -0,0 +1,45 @@
+﻿#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// \brief Пул потоков с общей очередью задач.
+///
+/// Задачи выполняются в порядке добавления свободными потоками. Задачи не должны выбрасывать
+/// исключения — ошибки передаются через захваченные переменные. Деструктор дожидается
+/// выполнения всех добавленных задач.
+class ThreadPool {
+public:
+    /// \brief Запускает потоки.
+    /// \param threads Число потоков; 0 — по числу ядер.
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Добавляет задачу в очередь
+    void submit(std::function<void()> task);
+
+    /// Ждёт, пока очередь опустеет и все начатые задачи завершатся
+    void wait();
+
+    /// Число потоков
+    int size() const { return (int)workers.size(); }
+
+private:
+    std::vector<std::thread> workers;           // Потоки пула
+    std::deque<std::function<void()>> tasks;    // Очередь задач
+    std::mutex mutex;                           // Защищает tasks, running, stopping
+    std::condition_variable available;          // Появилась задача или пул останавливается
+    std::condition_variable idle;               // Все задачи выполнены
+    size_t running = 0;                         // Выполняется задач сейчас
+    bool stopping = false;                      // Пул останавливается
+
+    /// Цикл потока: берёт задачи, пока пул не остановлен
+    void workerLoop();
+};
@@ -0,0 +1,77 @@
+﻿#include "Trajectory.h"
+#include <algorithm>
+
+TrajectoryClassifier::TrajectoryClassifier(const Polygon& polygon)
+    : polygon(polygon), index(polygon)
+{
+}
+
+int TrajectoryClassifier::classify(const std::vector<Point>& track, std::vector<bool>& results, std::vector<TrajectoryEvent>& events) const {
+    results.assign(track.size(), false);
+    events.clear();
+    if (track.empty()) return 0;
+
+    // Первая точка — полная проверка
+    int fullChecks = 1;
+    bool inside = polygon.contains(track[0]);
+    results[0] = inside;
+
+    struct Crossing {
+        double t;  // Параметр точки пересечения на отрезке трека (0 — предыдущая точка, 1 — текущая)
+        int edge;  // Индекс ребра
+    };
+    std::vector<int> candidates;
+    std::vector<Crossing> crossings;
+
+    for (size_t k = 1; k < track.size(); ++k) {
+        const Point& from = track[k - 1];
+        const Point& to = track[k];
+        if (from == to) {  // Стоянка — состояние не меняется
+            results[k] = inside;
+            continue;
+        }
+
+        index.segmentCandidates(from, to, candidates);
+        crossings.clear();
+        int touchedEdge = -1;  // Ребро, которого отрезок касается (вершина, конец отрезка или наложение)
+        for (int e : candidates) {
+            const Point& a = index.edgeStart(e);
+            const Point& b = index.edgeEnd(e);
+            int o1 = crossSign(from, to, a);
+            int o2 = crossSign(from, to, b);
+            int o3 = crossSign(a, b, from);
+            int o4 = crossSign(a, b, to);
+            if (o1 * o2 < 0 && o3 * o4 < 0) {
+                // Собственное пересечение: концы каждого отрезка строго по разные стороны другого
+                double cFrom = crossProduct(a, b, from);
+                double cTo = crossProduct(a, b, to);
+                crossings.push_back({ cFrom / (cFrom - cTo), e });
+            }
+            else if ((o1 == 0 && pointOnSegment(from, a, to)) || (o2 == 0 && pointOnSegment(from, b, to)) ||
+                (o3 == 0 && pointOnSegment(a, from, b)) || (o4 == 0 && pointOnSegment(a, to, b))) {
+                if (touchedEdge < 0) touchedEdge = e;
+            }
+        }
+        std::sort(crossings.begin(), crossings.end(), [](const Crossing& l, const Crossing& r) { return l.t < r.t; });
+
+        if (touchedEdge >= 0) {
+            // Касание границы: чётность пересечений ничего не говорит — проверяем точку полностью
+            ++fullChecks;
+            bool now = polygon.contains(to);
+            if (now != inside) {
+                int edge = crossings.empty() ? touchedEdge : crossings.back().edge;
+                events.push_back({ (int)k, edge, now });
+            }
+            inside = now;
+        }
+        else {
+            // Каждое собственное пересечение меняет состояние
+            for (const Crossing& c : crossings) {
+                inside = !inside;
+                events.push_back({ (int)k, c.edge, inside });
+            }
+        }
+        results[k] = inside;
+    }
+    return fullChecks;
+}
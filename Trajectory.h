@@ -0,0 +1,38 @@
+﻿#pragma once
+
+#include "EdgeIndex.h"
+#include "Point.h"
+#include "Polygon.h"
+#include <vector>
+
+/// \brief Событие пересечения границы многоугольника траекторией.
+struct TrajectoryEvent {
+    int pointIndex;  // Индекс точки трека, на отрезке к которой произошло событие
+    int edgeIndex;   // Индекс пересечённого ребра (ребро i: вершины i и (i + 1) % n); -1 — неизвестно
+    bool entering;   // true — вход в многоугольник, false — выход из него
+};
+
+/// \brief Классификация последовательности близких точек (GPS-трека) с использованием когерентности.
+///
+/// Первая точка проверяется полностью через Polygon::contains. Для каждой следующей точки
+/// проверяется только отрезок от предыдущей точки: кандидаты берутся из EdgeIndex, и при нечётном
+/// числе собственных пересечений рёбер состояние меняется на противоположное. Если отрезок касается
+/// границы (проходит через вершину, лежит на ребре, начинается или заканчивается на границе),
+/// точка проверяется полностью — граница по-прежнему считается принадлежащей многоугольнику.
+class TrajectoryClassifier {
+public:
+    /// \brief Строит классификатор для валидного многоугольника.
+    /// \param polygon Многоугольник (копируется вместе с построенным индексом рёбер).
+    explicit TrajectoryClassifier(const Polygon& polygon);
+
+    /// \brief Классифицирует точки трека по порядку.
+    /// \param[in]  track   Точки трека.
+    /// \param[out] results results[i] — принадлежит ли точка i многоугольнику (внутри или на границе).
+    /// \param[out] events  События входа/выхода в порядке следования по треку.
+    /// \return Количество полных проверок contains (первая точка и касания границы).
+    int classify(const std::vector<Point>& track, std::vector<bool>& results, std::vector<TrajectoryEvent>& events) const;
+
+private:
+    Polygon polygon;  // Копия многоугольника для полных проверок
+    EdgeIndex index;  // Индекс рёбер для отбора кандидатов на пересечение
+};
@@ -5,7 +5,30 @@
 #include "../Polygon/Validator.h"
 #include "../Polygon/Point.h"
 #include "../Polygon/Polygon.h"
+#include "../Polygon/Trajectory.h"
+#include "../Polygon/RasterMask.h"
+#include "../Polygon/LatticeScanner.h"
+#include "../Polygon/SpatialJoin.h"
+#include "../Polygon/FileParser.h"
+#include "../Polygon/IOManager.h"
+#include "../Polygon/BoundedQueue.h"
+#include "../Polygon/BatchPipeline.h"
+#include "../Polygon/ResultWriter.h"
+#include "../Polygon/PolygonCompiler.h"
+#include "../Polygon/PolygonSnapshot.h"
+#include "../Polygon/ApproximationFilter.h"
+#include "../Polygon/PolygonApi.h"
+#include "../Polygon/ManifestRunner.h"
+#include "../Polygon/ThreadPool.h"
+#include "../Polygon/CrossingQuery.h"
+#include "../Polygon/OutOfCoreJoin.h"
 
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
 #include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -487,4 +510,820 @@ namespace UnitTests
             Assert::IsFalse(Polygon(uNegFrac).contains({ -2.5f, -2.5f }));
         }
     };
+
+    TEST_CLASS(TrajectoryTests)
+    {
+    public:
+        TEST_METHOD(Classify_MatchesContains)
+        {
+            std::vector<Point> u{ {0,0},{4,0},{4,4},{3,4},{3,1},{1,1},{1,4},{0,4} };
+            std::vector<Point> track{ {-1,2},{0.5f,2},{2,2},{3.5f,2},{3.5f,0.5f},{2,0.5f},{2,-1} };
+            Polygon poly(u);
+            TrajectoryClassifier tc(poly);
+            std::vector<bool> results;
+            std::vector<TrajectoryEvent> events;
+            tc.classify(track, results, events);
+            for (size_t i = 0; i < track.size(); ++i) {
+                Assert::AreEqual(poly.contains(track[i]), (bool)results[i]);
+            }
+        }
+        TEST_METHOD(Classify_EntryExitEvents)
+        {
+            std::vector<Point> rect{ {0,0},{4,0},{4,3},{0,3} };
+            std::vector<Point> track{ {-1,1},{2,1},{5,1} };
+            TrajectoryClassifier tc((Polygon(rect)));
+            std::vector<bool> results;
+            std::vector<TrajectoryEvent> events;
+            Assert::AreEqual(1, tc.classify(track, results, events));
+            Assert::AreEqual((size_t)2, events.size());
+            Assert::IsTrue(events[0].entering);
+            Assert::AreEqual(3, events[0].edgeIndex);
+            Assert::IsFalse(events[1].entering);
+            Assert::AreEqual(1, events[1].edgeIndex);
+        }
+        TEST_METHOD(Classify_BoundaryFallsBackToContains)
+        {
+            std::vector<Point> rect{ {0,0},{4,0},{4,3},{0,3} };
+            std::vector<Point> track{ {-1,1},{0,1},{-1,2} };
+            TrajectoryClassifier tc((Polygon(rect)));
+            std::vector<bool> results;
+            std::vector<TrajectoryEvent> events;
+            Assert::AreEqual(3, tc.classify(track, results, events));
+            Assert::IsTrue(results[1]);
+            Assert::IsFalse(results[2]);
+        }
+    };
+
+    TEST_CLASS(RasterMaskTests)
+    {
+    public:
+        TEST_METHOD(Contains_MatchesPolygonOnLattice)
+        {
+            std::vector<Point> u{ {0,0},{4,0},{4,4},{3,4},{3,1},{1,1},{1,4},{0,4} };
+            Polygon poly(u);
+            RasterMask mask(poly, 16, 16);
+            for (int x = -1; x <= 5; ++x) {
+                for (int y = -1; y <= 5; ++y) {
+                    Point p((float)x + 0.25f, (float)y + 0.5f);
+                    Assert::AreEqual(poly.contains(p), mask.contains(p));
+                }
+            }
+        }
+        TEST_METHOD(Lookup_InteriorCellIsSingleBit)
+        {
+            std::vector<Point> rect{ {0,0},{8,0},{8,8},{0,8} };
+            RasterMask mask(Polygon(rect), 8, 8);
+            Assert::IsTrue(mask.lookup({ 4.5f, 4.5f }) == MaskCell::inside);
+            Assert::IsTrue(mask.lookup({ 0.5f, 4.5f }) == MaskCell::boundary);
+            Assert::IsTrue(mask.lookup({ 9.0f, 4.5f }) == MaskCell::outside);
+        }
+        TEST_METHOD(SaveLoad_RoundTrip)
+        {
+            std::vector<Point> u{ {0,0},{4,0},{4,4},{3,4},{3,1},{1,1},{1,4},{0,4} };
+            Polygon poly(u);
+            RasterMask mask(poly, 32, 32);
+            Error err;
+            Assert::IsTrue(mask.save("raster_mask_test.bin", err));
+            RasterMask loaded;
+            Assert::IsTrue(loaded.load("raster_mask_test.bin", err));
+            Assert::AreEqual(mask.boundaryCellCount(), loaded.boundaryCellCount());
+            Assert::IsFalse(loaded.contains({ 2.0f, 2.0f }));
+            Assert::IsTrue(loaded.contains({ 0.5f, 2.0f }));
+        }
+    };
+
+    TEST_CLASS(LatticeScannerTests)
+    {
+    public:
+        TEST_METHOD(Count_Rectangle)
+        {
+            std::vector<Point> rect{ {0,0},{4,0},{4,3},{0,3} };
+            LatticeCount c = LatticeScanner(Polygon(rect)).count();
+            Assert::AreEqual(6LL, c.inside);
+            Assert::AreEqual(14LL, c.boundary);
+        }
+        TEST_METHOD(Count_ConcaveU_PickTheorem)
+        {
+            std::vector<Point> u{ {0,0},{4,0},{4,4},{3,4},{3,1},{1,1},{1,4},{0,4} };
+            Polygon poly(u);
+            LatticeCount c = LatticeScanner(poly).count();
+            // Формула Пика: 2A = 2I + B - 2
+            Assert::AreEqual(poly.signedArea(), 2 * c.inside + c.boundary - 2);
+        }
+        TEST_METHOD(Enumerate_MatchesContains)
+        {
+            std::vector<Point> star{ {0,3},{1,1},{3,0},{1,-1},{0,-3},{-1,-1},{-3,0},{-1,1} };
+            Polygon poly(star);
+            std::vector<Point> inside, boundary;
+            LatticeScanner(poly).enumerate(inside, boundary);
+            long long expected = 0;
+            for (int x = -3; x <= 3; ++x) {
+                for (int y = -3; y <= 3; ++y) {
+                    if (poly.contains(Point((float)x, (float)y))) ++expected;
+                }
+            }
+            Assert::AreEqual(expected, (long long)(inside.size() + boundary.size()));
+        }
+    };
+
+    TEST_CLASS(SpatialJoinTests)
+    {
+    public:
+        TEST_METHOD(Join_ResultsInOriginalOrder)
+        {
+            std::vector<Point> a{ {0,0},{4,0},{4,4},{0,4} };
+            std::vector<Point> b{ {2,2},{6,2},{6,6},{2,6} };
+            std::vector<Polygon> polygons{ Polygon(a), Polygon(b) };
+            SpatialJoin join(polygons);
+            std::vector<Point> points{ {5,5},{1,1},{3,3},{9,9} };
+            JoinResult result;
+            JoinStats stats;
+            join.join(points, result, stats);
+            Assert::AreEqual((size_t)4, stats.points);
+            Assert::AreEqual((size_t)4, stats.matches);
+            Assert::AreEqual((size_t)1, result.offsets[1] - result.offsets[0]);
+            Assert::AreEqual(1, result.polygonIds[result.offsets[0]]);
+            Assert::AreEqual(0, result.polygonIds[result.offsets[1]]);
+            Assert::AreEqual((size_t)2, result.offsets[3] - result.offsets[2]);
+            Assert::AreEqual(result.offsets[3], result.offsets[4]);
+        }
+        TEST_METHOD(MortonKey_InterleavesBits)
+        {
+            BoundingBox box;
+            box.maxX = 65535;
+            box.maxY = 65535;
+            Assert::AreEqual(0u, SpatialJoin::mortonKey({ 0, 0 }, box));
+            Assert::AreEqual(1u, SpatialJoin::mortonKey({ 1, 0 }, box));
+            Assert::AreEqual(2u, SpatialJoin::mortonKey({ 0, 1 }, box));
+            Assert::AreEqual(3u, SpatialJoin::mortonKey({ 1, 1 }, box));
+        }
+    };
+
+    TEST_CLASS(BatchPipelineTests)
+    {
+    public:
+        TEST_METHOD(BoundedQueue_FifoAndCapacity)
+        {
+            BoundedQueue<int> queue(4);
+            for (int i = 0; i < 4; ++i) {
+                int value = i;
+                Assert::IsTrue(queue.tryPush(value));
+            }
+            int extra = 4;
+            Assert::IsFalse(queue.tryPush(extra));
+            for (int i = 0; i < 4; ++i) {
+                Assert::AreEqual(i, queue.pop());
+            }
+            int value = 0;
+            Assert::IsFalse(queue.tryPop(value));
+        }
+        TEST_METHOD(Run_ResultsInInputOrder)
+        {
+            {
+                std::ofstream fout("pipeline_in.txt");
+                fout << "4\n0;0\n4;0\n4;4\n0;4\n";
+                for (int i = 0; i < 1000; ++i) fout << (i % 8) << ";1\n";
+            }
+            FileParser parser;
+            std::vector<Point> vertices;
+            long long bodyOffset = 0;
+            int headerLines = 0;
+            Error err;
+            Assert::IsTrue(parser.readPolygonHeader("pipeline_in.txt", vertices, bodyOffset, headerLines, err));
+            Assert::AreEqual(5, headerLines);
+            PipelineOptions options;
+            options.chunkBytes = 64;  // Много маленьких блоков — проверка порядка записи
+            PipelineStats stats;
+            Assert::IsTrue(BatchPipeline(Polygon(vertices), options).run("pipeline_in.txt", bodyOffset, headerLines + 1, "pipeline_out.txt", err, &stats));
+            Assert::AreEqual((size_t)1000, stats.points);
+            std::ifstream fin("pipeline_out.txt");
+            std::string line;
+            for (int i = 0; i < 1000; ++i) {
+                Assert::IsTrue((bool)std::getline(fin, line));
+                Assert::AreEqual(std::string(IOManager::resultText(i % 8 <= 4)), line);
+            }
+        }
+        TEST_METHOD(Run_ReportsGlobalLineOfError)
+        {
+            {
+                std::ofstream fout("pipeline_bad.txt");
+                fout << "4\n0;0\n4;0\n4;4\n0;4\n";
+                for (int i = 0; i < 100; ++i) fout << (i == 57 ? "1;a" : "1;1") << "\n";
+            }
+            FileParser parser;
+            std::vector<Point> vertices;
+            long long bodyOffset = 0;
+            int headerLines = 0;
+            Error err;
+            Assert::IsTrue(parser.readPolygonHeader("pipeline_bad.txt", vertices, bodyOffset, headerLines, err));
+            PipelineOptions options;
+            options.chunkBytes = 64;
+            Assert::IsFalse(BatchPipeline(Polygon(vertices), options).run("pipeline_bad.txt", bodyOffset, headerLines + 1, "pipeline_out.txt", err));
+            Assert::IsTrue(err.type == ErrorType::invalidCharacters);
+            Assert::AreEqual(63, err.errorLineNumber);
+        }
+    };
+
+    TEST_CLASS(ResultWriterTests)
+    {
+    public:
+        // Содержимое файла целиком (двоичный режим)
+        static std::string readAll(const char* fileName)
+        {
+            std::ifstream fin(fileName, std::ios::binary);
+            return std::string((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+        }
+        TEST_METHOD(ByteAndBitsetFormats)
+        {
+            const bool results[] = { true, false, true, true, false, false, false, true, true, false };
+            ResultWriterOptions options;
+            options.bufferBytes = 1;  // Сброс на диск при каждом заполнении буфера
+            Error err;
+            for (ResultFormat format : { ResultFormat::byte, ResultFormat::bitset }) {
+                options.format = format;
+                ResultWriter writer(options);
+                Assert::IsTrue(writer.open("writer_out.bin", err));
+                for (bool result : results) writer.write(result);
+                Assert::IsTrue(writer.close(err));
+                Assert::AreEqual((size_t)10, writer.count());
+                std::string data = readAll("writer_out.bin");
+                if (format == ResultFormat::byte) {
+                    Assert::AreEqual((size_t)10, data.size());
+                    for (int i = 0; i < 10; ++i) Assert::AreEqual(results[i] ? 1 : 0, (int)data[i]);
+                }
+                else {
+                    Assert::AreEqual((size_t)2, data.size());
+                    Assert::AreEqual(0x8D, (int)(unsigned char)data[0]);
+                    Assert::AreEqual(0x01, (int)(unsigned char)data[1]);
+                }
+            }
+        }
+        TEST_METHOD(CsvAndTextFormats)
+        {
+            std::vector<uint8_t> results{ 1, 0, 1 };
+            ResultWriterOptions options;
+            options.format = ResultFormat::csv;
+            Error err;
+            {
+                ResultWriter writer(options);
+                Assert::IsTrue(writer.open("writer_out.txt", err));
+                writer.write(results.data(), results.size());
+                Assert::IsTrue(writer.close(err));
+            }
+            std::ifstream fin("writer_out.txt");
+            std::string line;
+            const char* expected[] = { "id,inside", "0,1", "1,0", "2,1" };
+            for (const char* text : expected) {
+                Assert::IsTrue((bool)std::getline(fin, line));
+                Assert::AreEqual(std::string(text), line);
+            }
+            fin.close();
+
+            Assert::IsTrue(IOManager::writeResults("writer_out.txt", { false, true }, err));
+            fin.open("writer_out.txt");
+            Assert::IsTrue((bool)std::getline(fin, line));
+            Assert::AreEqual(std::string(IOManager::resultText(false)), line);
+            Assert::IsTrue((bool)std::getline(fin, line));
+            Assert::AreEqual(std::string(IOManager::resultText(true)), line);
+            Assert::IsFalse((bool)std::getline(fin, line));
+        }
+        TEST_METHOD(DirectIoMatchesBuffered)
+        {
+            ResultWriterOptions options;
+            options.format = ResultFormat::byte;
+            options.bufferBytes = 8192;
+            options.directIo = true;  // Без поддержки O_DIRECT — обычная запись
+            Error err;
+            ResultWriter writer(options);
+            Assert::IsTrue(writer.open("writer_out.bin", err));
+            for (int i = 0; i < 20001; ++i) writer.write(i % 3 == 0);
+            Assert::IsTrue(writer.close(err));
+            std::string data = readAll("writer_out.bin");
+            Assert::AreEqual((size_t)20001, data.size());
+            for (int i = 0; i < 20001; ++i) Assert::AreEqual(i % 3 == 0 ? 1 : 0, (int)data[i]);
+        }
+        TEST_METHOD(OpenFailure)
+        {
+            ResultWriter writer;
+            Error err;
+            Assert::IsFalse(writer.open("no_such_dir/out.txt", err));
+            Assert::IsTrue(err.type == ErrorType::outputFileCreateFail);
+            ResultFormat format;
+            Assert::IsTrue(ResultWriter::parseFormat("bitset", format));
+            Assert::IsTrue(format == ResultFormat::bitset);
+            Assert::IsFalse(ResultWriter::parseFormat("xml", format));
+        }
+    };
+
+    TEST_CLASS(SelfIntersectionTests)
+    {
+    public:
+        TEST_METHOD(ReportsSameEdgeAsFullScan)
+        {
+            // Рёбра 0-1 и 2-3 пересекаются ("бабочка"), а также ребро 0-1 с ребром 4-5
+            std::vector<Point> v{ {0,0},{4,4},{4,0},{0,4},{-2,5},{2,-2} };
+            Polygon p(v);
+            int first = -1, second = -1;
+            Assert::IsTrue(p.findSelfIntersection(first, second));
+            Assert::AreEqual(0, first);
+            Assert::AreEqual(2, second);
+            Error err;
+            Assert::IsFalse(p.checkPolygonShape(err));
+            Assert::AreEqual(4, err.errorLineNumber);
+        }
+        TEST_METHOD(ParallelMatchesSequential)
+        {
+            // Зубчатая окружность с вдавленными внутрь вершинами
+            std::vector<Point> v;
+            const int n = 4000;
+            for (int i = 0; i < n; ++i) {
+                double angle = 6.283185307179586 * i / n;
+                double r = (i % 2) ? 90000.0 : 89970.0;
+                v.push_back({ (float)std::round(r * std::cos(angle)), (float)std::round(r * std::sin(angle)) });
+            }
+            int first = -1, second = -1;
+            Assert::IsFalse(Polygon(v).findSelfIntersection(first, second, 4));
+            std::swap(v[1500], v[1503]);  // Перестановка вершин даёт пересечение соседних рёбер
+            std::swap(v[700], v[710]);
+            Polygon broken(v);
+            int seqFirst = -1, seqSecond = -1;
+            Assert::IsTrue(broken.findSelfIntersection(seqFirst, seqSecond, 1));
+            Assert::IsTrue(broken.findSelfIntersection(first, second, 4));
+            Assert::AreEqual(seqFirst, first);
+            Assert::AreEqual(seqSecond, second);
+            Assert::IsTrue(seqFirst < 710);
+        }
+    };
+
+    TEST_CLASS(PolygonCompilerTests)
+    {
+    public:
+        TEST_METHOD(EmitsUnrolledConstexprContains)
+        {
+            std::vector<Point> v{ {0,0},{10,0},{10,10},{6,4},{3,9},{-2,7},{2,5} };
+            std::ostringstream out;
+            PolygonCompiler::emitHeader(Polygon(v), "fence", "fence.txt", out);
+            std::string header = out.str();
+            Assert::IsTrue(header.find("namespace fence {") != std::string::npos);
+            Assert::IsTrue(header.find("constexpr int vertexCount = 7;") != std::string::npos);
+            Assert::IsTrue(header.find("constexpr bool contains(double x, double y)") != std::string::npos);
+            Assert::IsTrue(header.find("for (") == std::string::npos);  // Цикл полностью развёрнут
+            size_t edges = 0;
+            for (size_t pos = header.find("// Ребро "); pos != std::string::npos; pos = header.find("// Ребро ", pos + 1)) ++edges;
+            Assert::AreEqual((size_t)7, edges);
+            // Горизонтальное ребро 0 не даёт слагаемого чётности: 6 рёбер из 7
+            size_t crossings = 0;
+            for (size_t pos = header.find("inside ^="); pos != std::string::npos; pos = header.find("inside ^=", pos + 1)) ++crossings;
+            Assert::AreEqual((size_t)6, crossings);
+        }
+        TEST_METHOD(IdentifierFromPath)
+        {
+            Assert::AreEqual(std::string("geo_fence"), PolygonCompiler::identifierFromPath("out/geo-fence.h"));
+            Assert::AreEqual(std::string("_9zone"), PolygonCompiler::identifierFromPath("C:\\fences\\9zone.hpp"));
+        }
+    };
+
+    TEST_CLASS(PolygonSnapshotTests)
+    {
+    public:
+        TEST_METHOD(RoundTripMatchesContains)
+        {
+            std::vector<Point> v{ {0,0},{10,0},{10,10},{6,4},{3,9},{-2,7},{2,5} };
+            Polygon polygon(v);
+            Error err;
+            Assert::IsTrue(PolygonSnapshot::write(polygon, "snapshot.bin", err, 3));
+            PolygonSnapshot snapshot;
+            Assert::IsTrue(snapshot.open("snapshot.bin", err));
+            Assert::AreEqual(7, snapshot.vertexCount());
+            Assert::IsTrue(snapshot.verify());
+            Assert::IsTrue(snapshot.fingerprint() == PolygonSnapshot::fingerprintOf(v));
+            for (int x = -4; x <= 12; ++x) {
+                for (int y = -2; y <= 12; ++y) {
+                    Point p((float)x, (float)y);
+                    Assert::AreEqual(polygon.contains(p), snapshot.contains(p));
+                }
+            }
+        }
+        TEST_METHOD(RejectsDamagedFile)
+        {
+            std::vector<Point> v{ {0,0},{4,0},{4,4},{2,1},{0,4} };
+            Error err;
+            Assert::IsTrue(PolygonSnapshot::write(Polygon(v), "snapshot.bin", err));
+            {
+                std::ofstream fout("snapshot.bin", std::ios::binary | std::ios::app);
+                fout.put('\0');  // Размер файла больше не совпадает с заголовком
+            }
+            PolygonSnapshot snapshot;
+            Assert::IsFalse(snapshot.open("snapshot.bin", err));
+            Assert::IsTrue(err.type == ErrorType::invalidFileFormat);
+            Assert::IsFalse(snapshot.contains(Point(1, 1)));
+        }
+    };
+
+    TEST_CLASS(ApproximationFilterTests)
+    {
+    public:
+        // Зубчатый многоугольник: 40 зубцов по окружности
+        static Polygon gear()
+        {
+            std::vector<Point> v;
+            for (int i = 0; i < 80; ++i) {
+                double angle = 6.283185307179586 * i / 80;
+                double r = (i % 2) ? 500.0 : 430.0;
+                v.push_back({ (float)std::round(r * std::cos(angle)), (float)std::round(r * std::sin(angle)) });
+            }
+            return Polygon(v);
+        }
+        TEST_METHOD(ApproximationsAreNested)
+        {
+            Polygon polygon = gear();
+            ApproximationFilter filter(polygon, 12);
+            Assert::IsTrue(filter.outerHull().size() <= 12);
+            Assert::IsTrue(filter.innerPolygon().size() <= 12);
+            for (const Point& v : polygon.vertices) {
+                Assert::IsTrue(filter.classify(v) != FilterResult::outside);
+            }
+            for (const Point& v : filter.innerPolygon()) {
+                Assert::IsTrue(polygon.contains(v));
+            }
+        }
+        TEST_METHOD(ClassifyAgreesWithContains)
+        {
+            Polygon polygon = gear();
+            ApproximationFilter filter(polygon);
+            int decided = 0;
+            for (int x = -520; x <= 520; x += 8) {
+                for (int y = -520; y <= 520; y += 8) {
+                    Point p((float)x, (float)y);
+                    FilterResult result = filter.classify(p);
+                    if (result != FilterResult::uncertain) {
+                        Assert::AreEqual(polygon.contains(p), result == FilterResult::inside);
+                        ++decided;
+                    }
+                    Assert::AreEqual(polygon.contains(p), filter.contains(p));
+                }
+            }
+            Assert::IsTrue(decided > 0);
+        }
+    };
+
+    TEST_CLASS(PolygonApiTests)
+    {
+    public:
+        TEST_METHOD(CreateValidateContains)
+        {
+            const char text[] = "5\n0;0\n10;0\n10;10\n5;5\n0;10\n";
+            PolygonError error;
+            PolygonHandle* polygon = polygon_create_from_buffer(text, sizeof(text) - 1, &error);
+            Assert::IsNotNull(polygon);
+            Assert::AreEqual((int)POLYGON_OK, polygon_validate(polygon, &error));
+            Assert::AreEqual(5, polygon_vertex_count(polygon));
+            Assert::AreEqual(1, polygon_contains(polygon, 1, 1));
+            Assert::AreEqual(1, polygon_contains(polygon, 5, 5));   // Вершина — граница
+            Assert::AreEqual(0, polygon_contains(polygon, 5, 8));   // В вырезе
+            const float xy[] = { 1, 1, 5, 8, 20, 20, 10, 3 };
+            unsigned char results[4] = { 9, 9, 9, 9 };
+            Assert::AreEqual((int)POLYGON_OK, polygon_contains_batch(polygon, xy, 4, results));
+            Assert::AreEqual(1, (int)results[0]);
+            Assert::AreEqual(0, (int)results[1]);
+            Assert::AreEqual(0, (int)results[2]);
+            Assert::AreEqual(1, (int)results[3]);
+            polygon_free(polygon);
+        }
+        TEST_METHOD(ReportsErrors)
+        {
+            const char broken[] = "3\n0;0\n1;x\n2;2\n";
+            PolygonError error;
+            Assert::IsNull(polygon_create_from_buffer(broken, sizeof(broken) - 1, &error));
+            Assert::AreEqual((int)POLYGON_ERROR_PARSE, error.status);
+            Assert::AreEqual(3, error.line);
+            Assert::IsTrue(std::strlen(error.message) > 0);
+
+            const char convex[] = "4\n0;0\n10;0\n10;10\n0;10\n";
+            PolygonHandle* polygon = polygon_create_from_buffer(convex, sizeof(convex) - 1, nullptr);
+            Assert::IsNotNull(polygon);
+            int status = polygon_validate(polygon, &error);
+            Assert::AreEqual((int)POLYGON_ERROR_VALIDATION, status);
+            Assert::AreEqual((int)ErrorType::invalidPolygon, error.type);
+            polygon_free(polygon);
+
+            Assert::AreEqual(-1, polygon_contains(nullptr, 0, 0));
+            Assert::AreEqual((int)POLYGON_ERROR_ARGUMENT, polygon_validate(nullptr, nullptr));
+            polygon_free(nullptr);
+        }
+    };
+
+    TEST_CLASS(ManifestRunnerTests)
+    {
+    public:
+        TEST_METHOD(ThreadPoolRunsAllTasks)
+        {
+            std::atomic<int> sum(0);
+            {
+                ThreadPool pool(4);
+                Assert::AreEqual(4, pool.size());
+                for (int i = 1; i <= 1000; ++i) {
+                    pool.submit([&sum, i]() { sum += i; });
+                }
+                pool.wait();
+                Assert::AreEqual(500500, sum.load());
+                pool.submit([&sum]() { sum = 0; });
+            }
+            Assert::AreEqual(0, sum.load());  // Деструктор дожидается задач
+        }
+        TEST_METHOD(PerFileStatuses)
+        {
+            {
+                std::ofstream("manifest_ok.txt") << "5\n0;0\n10;0\n10;10\n5;5\n0;10\n1;1\n";
+                std::ofstream("manifest_out.txt") << "5\n0;0\n10;0\n10;10\n5;5\n0;10\n5;8\n";
+                std::ofstream("manifest_bad.txt") << "3\n0;0\n1;x\n2;2\n1;1\n";
+                std::ofstream("manifest.lst") << "# список\n\nmanifest_ok.txt;manifest_res.txt\n"
+                    << "manifest_out.txt\nmanifest_bad.txt\nmanifest_none.txt\n";
+            }
+            std::vector<ManifestEntry> entries;
+            Error err;
+            Assert::IsTrue(ManifestRunner::readManifest("manifest.lst", entries, err));
+            Assert::AreEqual((size_t)4, entries.size());
+            Assert::IsFalse(entries[0].output.empty());
+            Assert::IsTrue(entries[1].output.empty());
+
+            std::vector<FileStatus> statuses = ManifestRunner::run(entries, 3);
+            Assert::AreEqual((size_t)4, statuses.size());
+            Assert::AreEqual(0, statuses[0].code);
+            Assert::IsTrue(statuses[0].result);
+            Assert::AreEqual(0, statuses[1].code);
+            Assert::IsFalse(statuses[1].result);
+            Assert::AreEqual(2, statuses[2].code);
+            Assert::AreEqual(2, statuses[3].code);
+            Assert::AreEqual((int)ErrorType::inputFileNotExist, (int)statuses[3].err.type);
+
+            std::ifstream result("manifest_res.txt");
+            std::string line;
+            std::getline(result, line);
+            Assert::AreEqual(std::string(IOManager::resultText(true)), line.substr(0, line.find('\r')));
+
+            Assert::IsTrue(ManifestRunner::writeReport("manifest_report.txt", entries, statuses, err));
+            std::ifstream report("manifest_report.txt");
+            int lines = 0;
+            while (std::getline(report, line)) {
+                Assert::AreEqual(0, (int)line.find(entries[lines].input + ";" + std::to_string(statuses[lines].code) + ";"));
+                ++lines;
+            }
+            Assert::AreEqual(4, lines);
+        }
+        TEST_METHOD(RejectsBadManifest)
+        {
+            std::vector<ManifestEntry> entries;
+            Error err;
+            Assert::IsFalse(ManifestRunner::readManifest("manifest_missing.lst", entries, err));
+            Assert::AreEqual((int)ErrorType::inputFileNotExist, (int)err.type);
+
+            std::ofstream("manifest_empty.lst") << "# пусто\n";
+            Error empty;
+            Assert::IsFalse(ManifestRunner::readManifest("manifest_empty.lst", entries, empty));
+            Assert::AreEqual((int)ErrorType::emptyFile, (int)empty.type);
+
+            std::ofstream("manifest_broken.lst") << "a.txt\nb.txt;\n";
+            Error broken;
+            Assert::IsFalse(ManifestRunner::readManifest("manifest_broken.lst", entries, broken));
+            Assert::AreEqual((int)ErrorType::wrongElementCountInLine, (int)broken.type);
+            Assert::AreEqual(2, broken.errorLineNumber);
+        }
+    };
+
+    TEST_CLASS(PolygonRelationTests)
+    {
+    public:
+        static Polygon make(std::vector<std::pair<float, float>> points)
+        {
+            std::vector<Point> v;
+            for (const auto& p : points) {
+                Point q;
+                q.x = p.first;
+                q.y = p.second;
+                v.push_back(q);
+            }
+            return Polygon(v);
+        }
+        TEST_METHOD(NestedAndDisjoint)
+        {
+            Polygon zone = make({ {0, 0}, {10, 0}, {10, 10}, {5, 5}, {0, 10} });
+            Polygon inner = make({ {1, 1}, {3, 1}, {1, 3} });
+            Polygon far = make({ {20, 20}, {30, 20}, {20, 30} });
+            Assert::IsTrue(zone.containsPolygon(inner));
+            Assert::IsTrue(zone.intersects(inner));
+            Assert::IsTrue(inner.intersects(zone));   // Вложенный: границы не встречаются
+            Assert::IsFalse(inner.containsPolygon(zone));
+            Assert::IsFalse(zone.intersects(far));
+            Assert::IsFalse(zone.containsPolygon(far));
+        }
+        TEST_METHOD(TouchingBoundary)
+        {
+            Polygon zone = make({ {0, 0}, {10, 0}, {10, 10}, {5, 5}, {0, 10} });
+            Assert::IsTrue(zone.containsPolygon(zone));
+            Assert::IsTrue(zone.containsPolygon(make({ {0, 0}, {4, 0}, {0, 4} })));      // Рёбра на границе
+            Assert::IsTrue(zone.containsPolygon(make({ {5, 5}, {3, 3}, {7, 3} })));      // Вершина в вогнутой вершине
+            Assert::IsFalse(zone.containsPolygon(make({ {5, 5}, {6, 8}, {4, 8} })));     // Остальное в вырезе
+            Assert::IsTrue(zone.intersects(make({ {5, 5}, {6, 8}, {4, 8} })));
+            Assert::IsTrue(zone.intersects(make({ {10, 4}, {14, 2}, {14, 6} })));        // Касание вершиной ребра
+            Assert::IsFalse(zone.containsPolygon(make({ {10, 4}, {14, 2}, {14, 6} })));
+            Assert::IsFalse(zone.containsPolygon(make({ {2, 2}, {8, 2}, {5, 7} })));      // Пересекает вырез
+            Assert::IsTrue(zone.intersects(make({ {2, 2}, {8, 2}, {5, 7} })));
+        }
+        TEST_METHOD(ClockwiseOuter)
+        {
+            Polygon zone = make({ {0, 10}, {5, 5}, {10, 10}, {10, 0}, {0, 0} });
+            Assert::IsTrue(zone.containsPolygon(make({ {5, 5}, {3, 3}, {7, 3} })));
+            Assert::IsFalse(zone.containsPolygon(make({ {5, 5}, {6, 8}, {4, 8} })));
+        }
+    };
+
+    TEST_CLASS(CrossingQueryTests)
+    {
+    public:
+        static Point pt(float x, float y)
+        {
+            Point p;
+            p.x = x;
+            p.y = y;
+            return p;
+        }
+        TEST_METHOD(SegmentEntersAndLeaves)
+        {
+            Polygon zone({ pt(0, 0), pt(10, 0), pt(10, 10), pt(5, 5), pt(0, 10) });
+            CrossingQuery query(zone);
+            std::vector<Crossing> found;
+            query.crossings(pt(-2, 2), pt(12, 2), found);
+            Assert::AreEqual((size_t)2, found.size());
+            Assert::AreEqual(4, found[0].edge);  // Ребро (0;10)-(0;0)
+            Assert::IsTrue(found[0].kind == CrossingKind::entering);
+            Assert::AreEqual(2.0 / 14.0, found[0].t, 1e-12);
+            Assert::AreEqual(0.8, found[0].edgeT, 1e-12);
+            Assert::AreEqual(1, found[1].edge);
+            Assert::IsTrue(found[1].kind == CrossingKind::leaving);
+            Assert::IsTrue(query.crossesBoundary(pt(-2, 2), pt(12, 2)));
+
+            query.crossings(pt(20, 20), pt(30, 30), found);
+            Assert::IsTrue(found.empty());
+            query.crossings(pt(1, 1), pt(2, 2), found);  // Целиком внутри
+            Assert::IsTrue(found.empty());
+        }
+        TEST_METHOD(TouchingAndOverlap)
+        {
+            Polygon zone({ pt(0, 0), pt(10, 0), pt(10, 10), pt(5, 5), pt(0, 10) });
+            CrossingQuery query(zone);
+            std::vector<Crossing> found;
+            query.crossings(pt(2, 0), pt(6, 0), found);  // Наложение на ребро 0
+            Assert::AreEqual((size_t)1, found.size());
+            Assert::IsTrue(found[0].kind == CrossingKind::touching);
+            Assert::AreEqual(0.2, found[0].edgeT, 1e-12);
+
+            query.crossings(pt(5, 8), pt(5, 5), found);  // Конец в вогнутой вершине
+            Assert::AreEqual((size_t)2, found.size());
+            Assert::AreEqual(1.0, found[0].t);
+            Assert::IsFalse(query.crossesBoundary(pt(5, 8), pt(5, 5)));
+        }
+        TEST_METHOD(PolylineAndBatch)
+        {
+            Polygon zone({ pt(0, 0), pt(10, 0), pt(10, 10), pt(5, 5), pt(0, 10) });
+            CrossingQuery query(zone);
+            CrossingResult route;
+            query.polyline({ pt(-1, 1), pt(3, 1), pt(3, 12), pt(12, 12) }, route);
+            Assert::AreEqual((size_t)4, route.offsets.size());
+            Assert::AreEqual((size_t)1, route.offsets[1] - route.offsets[0]);
+            Assert::AreEqual((size_t)1, route.offsets[2] - route.offsets[1]);  // Выход через ребро (5;5)-(0;10)
+            Assert::AreEqual((size_t)0, route.offsets[3] - route.offsets[2]);
+            Assert::IsTrue(route.crossings[1].kind == CrossingKind::leaving);
+
+            std::vector<QuerySegment> segments;
+            for (int i = 0; i < 5000; ++i) {
+                segments.push_back({ pt((float)(i % 23) - 6, (float)(i % 17) - 3), pt((float)(i % 19) - 4, (float)(i % 13)) });
+            }
+            CrossingResult serial, parallel;
+            query.batch(segments, serial, 1);
+            query.batch(segments, parallel, 4);
+            Assert::IsTrue(serial.offsets == parallel.offsets);
+            std::vector<Crossing> single;
+            for (size_t i = 0; i < segments.size(); i += 97) {
+                query.crossings(segments[i].a, segments[i].b, single);
+                Assert::AreEqual(single.size(), serial.offsets[i + 1] - serial.offsets[i]);
+                for (size_t k = 0; k < single.size(); ++k) {
+                    Assert::AreEqual(single[k].edge, parallel.crossings[parallel.offsets[i] + k].edge);
+                }
+            }
+        }
+    };
+
+    TEST_CLASS(OutOfCoreJoinTests)
+    {
+    public:
+        TEST_METHOD(StreamPointsAndLayer)
+        {
+            {
+                std::ofstream layer("ooc_layer.txt");
+                layer << "5\n0;0\n10;0\n10;10\n5;5\n0;10\n4\n20;0\n30;0\n30;10\n20;10\n";
+                std::ofstream points("ooc_points.txt", std::ios::binary);
+                for (int i = 0; i < 50000; ++i) points << (i % 37) - 3 << ';' << (i % 13) - 1 << "\r\n";
+                points << "7;7";  // Последняя строка без перевода строки
+            }
+            FileParser parser;
+            std::vector<std::vector<Point>> layer;
+            std::vector<int> firstLines;
+            Error err;
+            Assert::IsTrue(parser.readPolygonLayer("ooc_layer.txt", layer, firstLines, err));
+            Assert::AreEqual((size_t)2, layer.size());
+            Assert::AreEqual(7, firstLines[1]);
+
+            uint64_t expected = 0;
+            size_t calls = 0;
+            Assert::IsTrue(parser.streamPoints("ooc_points.txt", 0, 1, 1 << 16, [&](const Point* p, size_t count, uint64_t first) {
+                Assert::AreEqual(expected, first);
+                for (size_t i = 0; i < count; ++i, ++expected) {
+                    if (expected < 50000) Assert::AreEqual((float)((int)(expected % 37) - 3), p[i].x);
+                    else Assert::AreEqual(7.0f, p[i].x);
+                }
+                ++calls;
+                return true;
+            }, err));
+            Assert::AreEqual((uint64_t)50001, expected);
+            Assert::IsTrue(calls > 1);
+
+            std::ofstream("ooc_bad.txt") << "1;1\n2;x\n";
+            Error bad;
+            Assert::IsFalse(parser.streamPoints("ooc_bad.txt", 0, 1, 1 << 16, [](const Point*, size_t, uint64_t) { return true; }, bad));
+            Assert::AreEqual(2, bad.errorLineNumber);
+        }
+        TEST_METHOD(MatchesContains)
+        {
+            std::vector<Polygon> polygons = {
+                Polygon({ Point(0, 0), Point(10, 0), Point(10, 10), Point(5, 5), Point(0, 10) }),
+                Polygon({ Point(-20, -20), Point(20, -20), Point(20, 20), Point(0, 0), Point(-20, 20) })
+            };
+            {
+                std::ofstream points("ooc_join.txt");
+                for (int i = 0; i < 20000; ++i) points << (i * 7) % 51 - 25 << ';' << (i * 11) % 47 - 23 << "\n";
+            }
+            OutOfCoreOptions options;
+            options.bucketsPerAxis = 4;
+            OutOfCoreJoin join(polygons, options);
+            JoinStats stats;
+            Error err;
+            Assert::IsTrue(join.run("ooc_join.txt", "ooc_result.txt", stats, err));
+            Assert::AreEqual(16, join.bucketCount());
+            Assert::AreEqual((size_t)20000, stats.points);
+
+            std::set<std::pair<long long, int>> expected, actual;
+            for (int i = 0; i < 20000; ++i) {
+                Point p((float)((i * 7) % 51 - 25), (float)((i * 11) % 47 - 23));
+                for (int k = 0; k < 2; ++k) {
+                    if (polygons[k].contains(p)) expected.insert({ i, k });
+                }
+            }
+            std::ifstream result("ooc_result.txt");
+            long long index;
+            char sep;
+            int id;
+            while (result >> index >> sep >> id) actual.insert({ index, id });
+            Assert::IsTrue(expected == actual);
+            Assert::AreEqual(expected.size(), stats.matches);
+            Assert::IsFalse(std::ifstream("ooc_result.txt.bucket0.tmp").is_open());  // Временные файлы удалены
+        }
+    };
+
+    TEST_CLASS(ParallelParseTests)
+    {
+    public:
+        TEST_METHOD(SameAsSequential)
+        {
+            std::string text;
+            for (int i = 0; i < 10000; ++i) text += std::to_string(i % 997 - 400) + ";" + std::to_string(i % 101) + (i % 3 ? "\n" : "\r\n");
+            std::vector<Point> sequential, parallel;
+            Error err;
+            Assert::IsTrue(FileParser::parsePoints(text.data(), text.size(), 1, sequential, err, 1));
+            Assert::AreEqual((size_t)10000, sequential.size());
+            for (int threads = 2; threads <= 7; ++threads) {
+                Assert::IsTrue(FileParser::parsePoints(text.data(), text.size(), 1, parallel, err, threads));
+                Assert::IsTrue(sequential == parallel);
+            }
+            text += "5;5";  // Последняя строка без перевода строки
+            Assert::IsTrue(FileParser::parsePoints(text.data(), text.size(), 1, parallel, err, 4));
+            Assert::AreEqual((size_t)10001, parallel.size());
+        }
+        TEST_METHOD(GlobalErrorLine)
+        {
+            std::string text;
+            for (int i = 0; i < 5000; ++i) {
+                if (i == 3210) text += "1;x\n";        // Первая ошибка: строка 7 + 3210
+                else if (i == 4500) text += "1.5\n";   // Вторая — не должна сообщаться
+                else text += "1;2\n";
+            }
+            for (int threads = 1; threads <= 8; ++threads) {
+                std::vector<Point> points;
+                Error err;
+                Assert::IsFalse(FileParser::parsePoints(text.data(), text.size(), 7, points, err, threads));
+                Assert::AreEqual((int)ErrorType::invalidCharacters, (int)err.type);
+                Assert::AreEqual(7 + 3210, err.errorLineNumber);
+            }
+        }
+    };
 }
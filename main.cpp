@@ -3,12 +3,240 @@
 #include <clocale>    // setlocale()
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <filesystem>
 
 #include "Error.h"
 #include "FileParser.h"
 #include "Validator.h"
 #include "Polygon.h"
 #include "IOManager.h"
+#include "ManifestRunner.h"
+#include "OutOfCoreJoin.h"
+#include "BatchPipeline.h"
+#include "PolygonCompiler.h"
+#include "PolygonSnapshot.h"
+#include "ResultWriter.h"
+#include "Trajectory.h"
+
+// Режим трека: многоугольник и последовательность точек, классификация с учётом когерентности
+static int runTrackMode(const std::string& inputPath, const std::string& outputPath) {
+    FileParser parser;
+    std::vector<Point> vertices;
+    std::vector<Point> track;  // Точки трека в порядке следования
+    Error err;
+
+    if (!parser.readPointsFromFile(inputPath, vertices, track, err)) {
+        IOManager::writeErrorToConsole(err);
+        return 2;
+    }
+
+    // Точки трека уже проверены на диапазон при разборе — валидатору передаём первую из них
+    Validator validator;
+    if (!validator.validate(vertices, track.front(), err)) {
+        IOManager::writeErrorToConsole(err);
+        return 3;
+    }
+
+    Polygon polygon(vertices);
+    if (!polygon.isValid(err)) {
+        IOManager::writeErrorToConsole(err);
+        return 4;
+    }
+
+    TrajectoryClassifier classifier(polygon);
+    std::vector<bool> results;
+    std::vector<TrajectoryEvent> events;
+    classifier.classify(track, results, events);
+
+    if (!IOManager::writeResults(outputPath, results, err)) {
+        IOManager::writeErrorToConsole(err);
+        return 5;
+    }
+
+    // События входа/выхода: номера строк входного файла (строка 1 — N, строки 2..N+1 — вершины)
+    int n = (int)vertices.size();
+    for (const TrajectoryEvent& e : events) {
+        std::cout << (e.entering ? "вход" : "выход") << ": строка " << e.pointIndex + n + 2;
+        if (e.edgeIndex >= 0) {
+            std::cout << ", ребро между строками " << e.edgeIndex + 2 << " и " << (e.edgeIndex + 1) % n + 2;
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
+
+// Чтение заголовка (N и вершины) и проверка многоугольника; строки после вершин не читаются.
+// Возвращает 0 или код завершения (2 — чтение, 3 — валидация, 4 — некорректный многоугольник).
+static int readValidPolygon(const std::string& inputPath, Polygon& polygon, long long& bodyOffset, int& headerLines) {
+    FileParser parser;
+    std::vector<Point> vertices;
+    Error err;
+
+    if (!parser.readPolygonHeader(inputPath, vertices, bodyOffset, headerLines, err)) {
+        IOManager::writeErrorToConsole(err);
+        return 2;
+    }
+
+    // Точки проверяются на диапазон при разборе — валидатору достаточно заведомо допустимой точки
+    Validator validator;
+    if (!validator.validate(vertices, vertices.front(), err)) {
+        IOManager::writeErrorToConsole(err);
+        return 3;
+    }
+
+    polygon = Polygon(vertices);
+    if (!polygon.isValid(err)) {
+        IOManager::writeErrorToConsole(err);
+        return 4;
+    }
+    return 0;
+}
+
+// Пакетный режим: многоугольник и произвольное число точек, чтение/разбор/проверка конвейером
+static int runBatchMode(const std::string& inputPath, const std::string& outputPath, const PipelineOptions& options) {
+    Polygon polygon;
+    long long bodyOffset = 0;  // Начало строк с точками
+    int headerLines = 0;       // Строк в заголовке (N и вершины)
+    if (int code = readValidPolygon(inputPath, polygon, bodyOffset, headerLines)) {
+        return code;
+    }
+
+    Error err;
+    BatchPipeline pipeline(polygon, options);
+    if (!pipeline.run(inputPath, bodyOffset, headerLines + 1, outputPath, err)) {
+        IOManager::writeErrorToConsole(err);
+        return err.type == ErrorType::outputFileCreateFail ? 5 : 2;
+    }
+    return 0;
+}
+
+// Режим компиляции: многоугольник из входного файла → C++-заголовок со специализированной проверкой
+static int runCompileMode(const std::string& inputPath, const std::string& outputPath) {
+    Polygon polygon;
+    long long bodyOffset = 0;
+    int headerLines = 0;
+    if (int code = readValidPolygon(inputPath, polygon, bodyOffset, headerLines)) {
+        return code;
+    }
+
+    Error err;
+    if (!PolygonCompiler::compileToFile(polygon, PolygonCompiler::identifierFromPath(outputPath), inputPath, outputPath, err)) {
+        IOManager::writeErrorToConsole(err);
+        return 5;
+    }
+    return 0;
+}
+
+// Режим снимка: проверенный многоугольник и его индекс рёбер → двоичный файл для быстрой загрузки
+static int runSnapshotMode(const std::string& inputPath, const std::string& outputPath) {
+    Polygon polygon;
+    long long bodyOffset = 0;
+    int headerLines = 0;
+    if (int code = readValidPolygon(inputPath, polygon, bodyOffset, headerLines)) {
+        return code;
+    }
+
+    Error err;
+    if (!PolygonSnapshot::write(polygon, outputPath, err)) {
+        IOManager::writeErrorToConsole(err);
+        return 5;
+    }
+    return 0;
+}
+
+// Режим манифеста: много входных файлов в одном процессе на пуле потоков, сводный отчёт
+static int runManifestMode(const std::string& manifestPath, const std::string& reportPath) {
+    Error err;
+    std::vector<ManifestEntry> entries;
+    if (!ManifestRunner::readManifest(manifestPath, entries, err)) {
+        IOManager::writeErrorToConsole(err);
+        return 2;
+    }
+    // Отчёт прошлого запуска в том же каталоге — не входной файл
+    std::error_code ec;
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const ManifestEntry& entry) {
+        return std::filesystem::equivalent(entry.input, reportPath, ec);
+    }), entries.end());
+
+    std::vector<FileStatus> statuses = ManifestRunner::run(entries);
+    if (!ManifestRunner::writeReport(reportPath, entries, statuses, err)) {
+        IOManager::writeErrorToConsole(err);
+        return 5;
+    }
+
+    // Коды 2–5 относятся к отдельным файлам и записаны в отчёт; в консоль — сводка
+    size_t failed = std::count_if(statuses.begin(), statuses.end(), [](const FileStatus& s) { return s.code != 0; });
+    std::cout << "Обработано файлов: " << statuses.size() << ", с ошибками: " << failed << std::endl;
+    return 0;
+}
+
+// Справка по параметрам командной строки
+static void printUsage() {
+    std::cerr << "Использование:\n"
+        << "  polygon.exe             (использует input.txt→output.txt)\n"
+        << "  polygon.exe <in>\n"
+        << "  polygon.exe <in> <out>\n"
+        << "  polygon.exe --track <in> <out>\n"
+        << "  polygon.exe --batch [--format=text|byte|bitset|csv] [--filter] <in> <out>\n"
+        << "  polygon.exe --compile <in> <out.h>\n"
+        << "  polygon.exe --snapshot <in> <out.snap>\n"
+        << "  polygon.exe --manifest <list.txt|dir> <report>\n"
+        << "  polygon.exe --join [--memory=<МиБ>] <layer> <points> <out>\n";
+}
+
+// Чтение и проверка слоя многоугольников (блоки "N и вершины" подряд).
+// Возвращает 0 или код завершения (2 — чтение, 3 — валидация, 4 — некорректный многоугольник).
+static int readValidLayer(const std::string& layerPath, std::vector<Polygon>& polygons) {
+    FileParser parser;
+    std::vector<std::vector<Point>> layer;
+    std::vector<int> firstLines;
+    Error err;
+
+    if (!parser.readPolygonLayer(layerPath, layer, firstLines, err)) {
+        IOManager::writeErrorToConsole(err);
+        return 2;
+    }
+
+    Validator validator;
+    polygons.clear();
+    for (size_t k = 0; k < layer.size(); ++k) {
+        Polygon polygon(layer[k]);
+        int code = 0;
+        if (!validator.validate(layer[k], layer[k].front(), err)) code = 3;
+        else if (!polygon.isValid(err)) code = 4;
+        if (code) {
+            // Номера строк валидатора считаются от начала блока — переводим в номера строк файла
+            if (err.errorLineNumber > 0) err.errorLineNumber += firstLines[k] - 1;
+            err.errorInputFileWay = layerPath;
+            err.errorMessage = "Многоугольник " + std::to_string(k) + ": " + err.errorMessage;
+            IOManager::writeErrorToConsole(err);
+            return code;
+        }
+        polygons.push_back(polygon);
+    }
+    return 0;
+}
+
+// Режим внешнего соединения: файл точек больше памяти раскладывается по корзинам на диске
+static int runJoinMode(const std::string& layerPath, const std::string& pointsPath, const std::string& outputPath,
+    const OutOfCoreOptions& options) {
+    std::vector<Polygon> polygons;
+    if (int code = readValidLayer(layerPath, polygons)) {
+        return code;
+    }
+
+    Error err;
+    JoinStats stats;
+    OutOfCoreJoin join(polygons, options);
+    if (!join.run(pointsPath, outputPath, stats, err)) {
+        IOManager::writeErrorToConsole(err);
+        return err.type == ErrorType::outputFileCreateFail ? 5 : 2;
+    }
+    std::cout << "Точек: " << stats.points << ", совпадений: " << stats.matches << ", корзин: " << join.bucketCount()
+        << ", " << (long long)stats.pointsPerSecond() << " точек/с" << std::endl;
+    return 0;
+}
 
 int main(int argc, char* argv[]) {
     // Переключаем консоль Windows в кодировку UTF-8, чтобы корректно выводить символы
@@ -22,6 +250,60 @@ int main(int argc, char* argv[]) {
     std::string inputPath = "input.txt";  // Задаём путь к файлу входных данных по умолчанию
     std::string outputPath = "output.txt";  // Задаём путь к файлу выходных данных по умолчанию
 
+    // Режим работы задаётся необязательным первым аргументом-флагом
+    std::string mode;
+    if (argc > 1 && (std::string(argv[1]) == "--track" || std::string(argv[1]) == "--batch" ||
+        std::string(argv[1]) == "--compile" || std::string(argv[1]) == "--snapshot" ||
+        std::string(argv[1]) == "--manifest" || std::string(argv[1]) == "--join")) {
+        mode = argv[1];
+        --argc;  // Сдвигаем аргументы: дальше разбор такой же, как в обычном режиме
+        ++argv;
+    }
+
+    // Настройки пакетного режима: --format=text|byte|bitset|csv и --filter
+    PipelineOptions batchOptions;
+    while (mode == "--batch" && argc > 1 && std::string(argv[1]).compare(0, 2, "--") == 0) {
+        std::string option = argv[1];
+        if (option.compare(0, 9, "--format=") == 0) {
+            if (!ResultWriter::parseFormat(option.substr(9), batchOptions.output.format)) {
+                std::cerr << "Ошибка: неизвестный формат результатов. Допустимо: text, byte, bitset, csv.\n";
+                return 1;
+            }
+        }
+        else if (option == "--filter") {
+            batchOptions.approximationFilter = true;
+        }
+        else {
+            std::cerr << "Ошибка: неизвестный параметр " << option << ".\n";
+            return 1;
+        }
+        --argc;
+        ++argv;
+    }
+
+    // Режим соединения: --memory=<МиБ> и три пути
+    OutOfCoreOptions joinOptions;
+    while (mode == "--join" && argc > 1 && std::string(argv[1]).compare(0, 2, "--") == 0) {
+        std::string option = argv[1];
+        char* end = nullptr;
+        long long megabytes = option.compare(0, 9, "--memory=") == 0 ? std::strtoll(option.c_str() + 9, &end, 10) : 0;
+        if (megabytes <= 0 || *end != '\0') {
+            std::cerr << "Ошибка: неизвестный параметр " << option << ".\n";
+            return 1;
+        }
+        joinOptions.memoryBudget = (size_t)megabytes << 20;
+        --argc;
+        ++argv;
+    }
+    if (mode == "--join") {
+        if (argc != 4) {
+            std::cerr << "Ошибка: режиму --join нужны файл слоя, файл точек и выходной файл.\n";
+            printUsage();
+            return 1;
+        }
+        return runJoinMode(argv[1], argv[2], argv[3], joinOptions);
+    }
+
     // Обработка аргументов командной строки
     if (argc == 2) {
         // Если указан только один аргумент (путь к входному файлу)
@@ -36,15 +318,28 @@ int main(int argc, char* argv[]) {
     }
     else if (argc > 3) {
         // Если аргументов больше двух — выводим сообщение об ошибке
-        std::cerr << "Ошибка: слишком много аргументов.\n"
-            << "Использование:\n"
-            << "  polygon.exe             (использует input.txt→output.txt)\n"
-            << "  polygon.exe <in>\n"
-            << "  polygon.exe <in> <out>\n";  // Сообщаем правильное использование программы
+        std::cerr << "Ошибка: слишком много аргументов.\n";
+        printUsage();  // Сообщаем правильное использование программы
         return 1;  // Завершаем программу с кодом ошибки 1
     }
     // если argc==1 — остаются input.txt и output.txt
 
+    if (mode == "--track") {
+        return runTrackMode(inputPath, outputPath);
+    }
+    if (mode == "--batch") {
+        return runBatchMode(inputPath, outputPath, batchOptions);
+    }
+    if (mode == "--compile") {
+        return runCompileMode(inputPath, outputPath);
+    }
+    if (mode == "--snapshot") {
+        return runSnapshotMode(inputPath, outputPath);
+    }
+    if (mode == "--manifest") {
+        return runManifestMode(inputPath, outputPath);
+    }
+
 // 1) Синтаксическое чтение данных из файла
     FileParser parser;  // Создаём объект для чтения данных из файла
     std::vector<Point> vertices;  // Вектор для хранения вершин многоугольника